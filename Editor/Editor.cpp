@@ -36,9 +36,32 @@ namespace TileEngine::Editor {
             yamlOut << YAML::Value;
             {
                 yamlOut << YAML::BeginMap;
-                yamlOut << YAML::Key << "path";
-                yamlOut << YAML::Value
-                        << std::filesystem::relative({tileMap->texturePath()}, std::filesystem::current_path());
+
+                const TileSheet& tileSheet{tileMap->tileSheet()};
+                const std::vector<TileSheet::SourceImage> sourceImages{tileSheet.sourceImages()};
+
+                // Several images are always combined with a texture array, so only a single image needs the flag.
+                if (sourceImages.size() > 1) {
+                    yamlOut << YAML::Key << "paths" << YAML::Value;
+                    yamlOut << YAML::BeginSeq;
+
+                    for (const TileSheet::SourceImage& sourceImage : sourceImages) {
+                        yamlOut << std::filesystem::relative({sourceImage.path}, std::filesystem::current_path());
+                    }
+
+                    yamlOut << YAML::EndSeq; // paths
+                } else {
+                    yamlOut << YAML::Key << "path";
+                    yamlOut << YAML::Value
+                            << std::filesystem::relative({tileMap->texturePath()}, std::filesystem::current_path());
+
+                    if (tileSheet.usesTextureArray()) {
+                        yamlOut << YAML::Key << "texture-array" << YAML::Value << true;
+                    } else if (tileSheet.isPadded()) {
+                        yamlOut << YAML::Key << "mipmaps" << YAML::Value << true;
+                    }
+                }
+
                 yamlOut << YAML::Key << "tile-size" << YAML::Comment("in pixels");
                 yamlOut << YAML::Value;
                 {
@@ -55,7 +78,40 @@ namespace TileEngine::Editor {
                 yamlOut << YAML::BeginMap;
                 yamlOut << YAML::Key << "width" << YAML::Value << tileMap->mapSize().x << YAML::Comment("in tiles");
                 yamlOut << YAML::Key << "height" << YAML::Value << tileMap->mapSize().y << YAML::Comment("in tiles");
-                yamlOut << YAML::Key << "tiles" << YAML::Value << YAML::Flow << tileMap->tiles();
+
+                if (tileMap->layerCount() == 1) {
+                    yamlOut << YAML::Key << "tiles" << YAML::Value << YAML::Flow << tileMap->tiles();
+                } else {
+                    yamlOut << YAML::Key << "layers" << YAML::Value;
+                    yamlOut << YAML::BeginSeq;
+
+                    for (int layer = 0; layer < tileMap->layerCount(); ++layer) {
+                        yamlOut << YAML::BeginMap;
+                        yamlOut << YAML::Key << "visible" << YAML::Value << tileMap->layerVisible(layer);
+                        yamlOut << YAML::Key << "opacity" << YAML::Value << tileMap->layerOpacity(layer);
+                        yamlOut << YAML::Key << "tiles" << YAML::Value << YAML::Flow << tileMap->tiles(layer);
+                        yamlOut << YAML::EndMap;
+                    }
+
+                    yamlOut << YAML::EndSeq; // layers
+                }
+
+                if (!tileMap->animations().empty()) {
+                    yamlOut << YAML::Key << "animations" << YAML::Value;
+                    yamlOut << YAML::BeginSeq;
+
+                    for (const auto& [tileID, frames, frameDuration] : tileMap->animations()) {
+                        yamlOut << YAML::BeginMap;
+                        yamlOut << YAML::Key << "tile" << YAML::Value << tileID;
+                        yamlOut << YAML::Key << "frames" << YAML::Value << YAML::Flow << frames;
+                        yamlOut << YAML::Key << "frame-duration" << YAML::Value << frameDuration
+                                << YAML::Comment("in seconds");
+                        yamlOut << YAML::EndMap;
+                    }
+
+                    yamlOut << YAML::EndSeq; // animations
+                }
+
                 yamlOut << YAML::EndMap; // tile-map
             }
             yamlOut << YAML::EndMap;
@@ -191,11 +247,15 @@ namespace TileEngine::Editor {
             render();
             renderTimer.endStep();
 
-            const std::string frameTimeSummary{std::format("Update Time: {:>5.2f} ms\nRender Time: {:>5.2f} ms",
-                                                           updateTimer.average(), renderTimer.average())};
+            const int drawCallCount{m_graphics.spriteBatch->takeDrawCallCount() +
+                                    m_guiGraphics.spriteBatch->takeDrawCallCount()};
+            const std::string frameTimeSummary{
+                std::format("Update Time: {:>5.2f} ms\nRender Time: {:>5.2f} ms\nDraw Calls: {:>5}",
+                            updateTimer.average(), renderTimer.average(), drawCallCount)};
             frameTimeText.setText(frameTimeSummary);
             frameTimeText.setPosition(topRight(*m_window));
             frameTimeText.render(m_guiGraphics);
+            m_guiGraphics.spriteBatch->flushText();
 
             m_window->postUpdate();
         }
@@ -380,7 +440,7 @@ namespace TileEngine::Editor {
         std::erase(m_guiObjects, m_tileSheetPanel);
 
         // Tile map display
-        auto tileSheet{std::make_unique<TileSheet>(Texture::create(image), tileSize)};
+        auto tileSheet{TileSheet::create(image, tileSize)};
         m_tileMap = std::make_shared<TileMap>(std::move(tileSheet), defaultMapSize, defaultTiles);
         m_tileMap->setAnchor(Anchor::center);
         m_tileMap->setLayer(1.0f);
@@ -657,9 +717,11 @@ namespace TileEngine::Editor {
         for (const auto& object : m_gameObjects) {
             object->render(m_graphics);
         }
+        m_graphics.spriteBatch->flushText();
 
         for (const auto& object : m_guiObjects) {
             object->render(m_guiGraphics);
         }
+        m_guiGraphics.spriteBatch->flushText();
     }
 } // namespace TileEngine::Editor
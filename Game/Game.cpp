@@ -67,6 +67,7 @@ namespace TileEngine {
         for (const auto& object : objects) {
             object->render(m_graphics);
         }
+        m_graphics.spriteBatch->flushText();
     }
 
     void Game::run() {
@@ -115,13 +116,17 @@ namespace TileEngine {
             renderTimer.endStep();
 
             // TODO: Convert frame time summary into game object?
-            const std::string frameTimeSummary{std::format("Update Time: {:>5.2f} ms\nRender Time: {:>5.2f} ms",
-                                                           updateTimer.average(), renderTimer.average())};
+            const int drawCallCount{m_graphics.spriteBatch->takeDrawCallCount() +
+                                    m_guiGraphics.spriteBatch->takeDrawCallCount()};
+            const std::string frameTimeSummary{
+                std::format("Update Time: {:>5.2f} ms\nRender Time: {:>5.2f} ms\nDraw Calls: {:>5}",
+                            updateTimer.average(), renderTimer.average(), drawCallCount)};
             const glm::vec2 position{-static_cast<float>(m_window->width()) / 2.0f,
                                      static_cast<float>(m_window->height()) / 2.0f};
             frameTimeText.setText(frameTimeSummary);
             frameTimeText.setPosition(position);
             frameTimeText.render(m_guiGraphics);
+            m_guiGraphics.spriteBatch->flushText();
 
             m_window->postUpdate();
         }
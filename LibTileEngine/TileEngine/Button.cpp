@@ -74,19 +74,14 @@ namespace TileEngine {
     }
 
     void Button::render(const Graphics& graphics) const {
-        graphics.quadShader.bind();
-        graphics.quadShader.setUniform("projectionViewMatrix", projectionViewMatrix(graphics.camera));
-
         // Draw the button fill color.
         const glm::vec2 anchorOffset{calculateAnchorOffset(size(), anchor(), size().y)};
         glm::vec2 offsetPosition{position() + anchorOffset};
         glm::mat4 transform{glm::translate(glm::mat4{1.0f}, {offsetPosition, layer()})};
         transform = glm::scale(transform, {size(), 1.0f});
-        graphics.quadShader.setUniform("transform", transform);
-        graphics.quadShader.setUniform("color", glm::vec4{m_currentStyle.fillColor, 1.0f});
-        graphics.quad.render();
+        graphics.spriteBatch->draw(graphics.camera, transform, glm::vec4{m_currentStyle.fillColor, 1.0f});
 
-        Outline::draw(*this, graphics.quadShader, graphics.quad, m_currentStyle.outline);
+        Outline::draw(*this, graphics, m_currentStyle.outline);
 
         m_text.render(graphics);
     }
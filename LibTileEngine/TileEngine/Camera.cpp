@@ -4,6 +4,9 @@
 // Created by Anthony on 26/03/2024.
 //
 
+#include <algorithm>
+#include <cmath>
+
 #include "glm/ext/matrix_clip_space.hpp"
 #include "glm/ext/matrix_transform.hpp"
 
@@ -18,14 +21,16 @@ namespace TileEngine {
 
         /// Generate a projection matrix for the given viewport size.
         /// @param viewport The width and height of the camera view in pixels.
-        glm::mat4 createProjectionMatrix(const glm::vec2& viewport) {
-            return glm::ortho(-viewport.x / 2.0f, viewport.x / 2.0f, -viewport.y / 2.0f, viewport.y / 2.0f, 0.1f,
-                              1000.0f);
+        /// @param zoom The scale from world units to screen pixels.
+        glm::mat4 createProjectionMatrix(const glm::vec2& viewport, const float zoom) {
+            const glm::vec2 halfExtent{viewport / (2.0f * zoom)};
+
+            return glm::ortho(-halfExtent.x, halfExtent.x, -halfExtent.y, halfExtent.y, 0.1f, 1000.0f);
         }
     } // namespace
 
     Camera::Camera(const glm::vec2 viewport, const glm::vec3 position) :
-        m_viewport(viewport), m_position(position), m_projection(createProjectionMatrix(viewport)) {
+        m_viewport(viewport), m_position(position), m_projection(createProjectionMatrix(viewport, m_zoom)) {
     }
 
     glm::mat4 Camera::perspectiveMatrix() const {
@@ -44,14 +49,25 @@ namespace TileEngine {
         return m_viewport;
     }
 
+    float Camera::zoom() const {
+        return m_zoom;
+    }
+
+    void Camera::setZoom(const float zoom) {
+        m_zoom = std::clamp(zoom, minZoom, maxZoom);
+        m_projection = createProjectionMatrix(m_viewport, m_zoom);
+    }
+
     Viewport Camera::viewport() const {
         const glm::vec2 position2D{m_position.x, m_position.y};
+        const glm::vec2 halfExtent{0.5f * m_viewport / m_zoom};
 
-        return {position2D - 0.5f * m_viewport, position2D + 0.5f * m_viewport};
+        return {position2D - halfExtent, position2D + halfExtent};
     }
 
     void Camera::update(const float deltaTime, const InputState& inputState) {
-        constexpr float speed = 512.0f;
+        // Movement is in screen pixels, so the camera covers the same distance on screen at any zoom level.
+        const float speed = 512.0f / m_zoom;
 
         if (inputState.key(GLFW_KEY_W)) {
             move(Direction::Up, deltaTime * speed);
@@ -73,22 +89,29 @@ namespace TileEngine {
 
         if (inputState.mouseButton(GLFW_MOUSE_BUTTON_MIDDLE) or inputState.key(GLFW_KEY_LEFT_ALT)) {
             if (mouseMovement.x < 0.0f) {
-                move(Direction::Left, std::abs(mouseMovement.x));
+                move(Direction::Left, std::abs(mouseMovement.x) / m_zoom);
             }
             else {
-                move(Direction::Right, std::abs(mouseMovement.x));
+                move(Direction::Right, std::abs(mouseMovement.x) / m_zoom);
             }
 
             if (mouseMovement.y < 0.0f) {
-                move(Direction::Up, std::abs(mouseMovement.y));
+                move(Direction::Up, std::abs(mouseMovement.y) / m_zoom);
             }
             else {
-                move(Direction::Down, std::abs(mouseMovement.y));
+                move(Direction::Down, std::abs(mouseMovement.y) / m_zoom);
             }
         }
 
+        // Each notch of the scroll wheel zooms in or out by a fixed ratio.
+        if (const float scrollDelta{inputState.scrollDelta()}; scrollDelta != 0.0f) {
+            constexpr float zoomStep{1.25f};
+            setZoom(m_zoom * std::pow(zoomStep, scrollDelta));
+        }
+
         if (inputState.keyDown(GLFW_KEY_C)) {
             resetPosition();
+            setZoom(1.0f);
         }
     }
 
@@ -116,17 +139,18 @@ namespace TileEngine {
 
     void Camera::onWindowResize(const glm::vec2 viewport) {
         m_viewport = viewport;
-        m_projection = createProjectionMatrix(viewport);
+        m_projection = createProjectionMatrix(viewport, m_zoom);
     }
 
     glm::vec2 screenToWorldCoordinates(const glm::vec2 screenCoordinates, const Camera& camera) {
         const auto [bottomLeft, topRight]{camera.viewport()};
-        return {screenCoordinates.x + bottomLeft.x, -screenCoordinates.y + topRight.y};
+        return {screenCoordinates.x / camera.zoom() + bottomLeft.x, -screenCoordinates.y / camera.zoom() + topRight.y};
     }
 
     Camera atOrigin(const Camera& camera) {
         Camera copy(camera);
         copy.resetPosition();
+        copy.setZoom(1.0f);
 
         return copy;
     }
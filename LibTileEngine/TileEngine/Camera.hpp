@@ -38,6 +38,15 @@ namespace TileEngine {
         /// @return the width and height in pixels.
         [[nodiscard]] glm::vec2 viewportSize() const;
 
+        /// Get the zoom level.
+        /// @return The scale from world units to screen pixels, where values above one zoom in and values below one
+        /// zoom out.
+        [[nodiscard]] float zoom() const;
+
+        /// Set the zoom level.
+        /// @param zoom The scale from world units to screen pixels. Clamped to `[minZoom, maxZoom]`.
+        void setZoom(float zoom);
+
         /// Get the visible area from the camera after all transforms.
         /// @return The viewport extents.
         [[nodiscard]] Viewport viewport() const;
@@ -55,6 +64,11 @@ namespace TileEngine {
         /// Moves the camera back to origin.
         void resetPosition();
 
+        /// The smallest zoom level, where one screen pixel covers many world units.
+        static constexpr float minZoom{1.0f / 256.0f};
+        /// The largest zoom level.
+        static constexpr float maxZoom{8.0f};
+
         /// Update the camera to match the window size when the user resizes the window.
         /// @param viewport The new window size.
         void onWindowResize(glm::vec2 viewport);
@@ -64,6 +78,8 @@ namespace TileEngine {
         glm::vec2 m_viewport;
         /// The position of the camera in world space.
         glm::vec3 m_position;
+        /// The scale from world units to screen pixels.
+        float m_zoom{1.0f};
         /// The projection matrix (e.g., perspective or orthographic).
         glm::mat4 m_projection;
     };
@@ -76,7 +92,7 @@ namespace TileEngine {
     /// right-handed coordinate system is used.
     glm::vec2 screenToWorldCoordinates(glm::vec2 screenCoordinates, const Camera& camera);
 
-    /// Get a copy of the camera positioned at the world origin.
+    /// Get a copy of the camera positioned at the world origin without any zoom.
     /// @param camera The camera to copy.
     /// @return A camera at the world origin.
     [[nodiscard]] Camera atOrigin(const Camera& camera);
@@ -5,8 +5,8 @@
 
 #include <TileEngine/Camera.hpp>
 #include <TileEngine/Font.hpp>
-#include <TileEngine/Shader.hpp>
 #include <TileEngine/Quad.hpp>
+#include <TileEngine/SpriteBatch.hpp>
 
 namespace TileEngine {
 
@@ -16,11 +16,12 @@ namespace TileEngine {
         Camera camera;
         /// The default font used for rendering text.
         std::unique_ptr<Font> font{Font::create("resource/font/Roboto-Regular.ttf", {288, 288}, {64, 64}, 32.0f)};
-        /// The shader intended for drawing a quad with an RGBA color.
-        Shader quadShader{Shader::create("resource/shader/grid.vert", "resource/shader/rgba.frag")};
-        // TODO: Create wrapper around quad and solid fill shader so that user only has to pass in camera + transform?
         /// A unit quad (width == height == 1 px) positioned at the world origin.
         Quad quad{};
+        /// Collects coloured and textured quads so that GUI objects can be drawn with a few draw calls.
+        /// @note Flush the batch before drawing with another shader, and flush it with `flushText` at the end of the
+        /// frame.
+        std::unique_ptr<SpriteBatch> spriteBatch{std::make_unique<SpriteBatch>()};
     };
 
 } // namespace TileEngine
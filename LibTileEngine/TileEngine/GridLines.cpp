@@ -1,61 +1,57 @@
 
 
-#include <format>
-#include <iostream>
-#include <vector>
-
 #include "glm/ext/matrix_transform.hpp"
 
 #include <TileEngine/GridLines.hpp>
 
 
 namespace TileEngine {
-    GridLines::GridLines(const glm::ivec2 size, const glm::vec2 cellSize) {
-        std::vector<float> vertices{};
+    GridLines::GridLines(const glm::ivec2 size, const glm::vec2 cellSize, const float lineWidth) :
+        m_gridSize(size), m_cellSize(cellSize), m_lineWidth(lineWidth) {
         const auto scaledSize{static_cast<glm::vec2>(size) * cellSize};
 
-        // Horizontal Lines
-        for (int row = 0; row <= size.y; ++row) {
-            const float y{static_cast<float>(row) * cellSize.y};
-            // Start Point
-            vertices.push_back(0);
-            vertices.push_back(y);
-            // End Point
-            vertices.push_back(scaledSize.x);
-            vertices.push_back(y);
-        }
-
-        // Vertical Lines
-        for (int col = 0; col <= size.x; ++col) {
-            const float x{static_cast<float>(col) * cellSize.x};
-            // Start Point
-            vertices.push_back(x);
-            vertices.push_back(0);
-            // End Point
-            vertices.push_back(x);
-            vertices.push_back(scaledSize.y);
-        }
-
-        m_vao.bind();
-        m_vbo.bind();
-        m_vbo.loadData(vertices, {2});
-
         Object::setPosition(-0.5f * scaledSize);
         Object::setSize(scaledSize);
     }
 
+    glm::ivec2 GridLines::gridSize() const {
+        return m_gridSize;
+    }
+
+    void GridLines::setGridSize(const glm::ivec2 size) {
+        m_gridSize = size;
+        Object::setSize(static_cast<glm::vec2>(size) * m_cellSize);
+    }
+
     void GridLines::update(float, const InputState&, const Camera&) {
     }
 
     void GridLines::render(const Graphics& graphics) const {
+        const auto [viewBottomLeft, viewTopRight]{graphics.camera.viewport()};
+        const glm::vec2 bottomLeft{TileEngine::bottomLeft(*this)};
+
+        // Pad the grid so that the lines on its outer edge are drawn at their full width.
+        const glm::vec2 padding{0.5f * m_lineWidth / graphics.camera.zoom() / m_cellSize};
+        const glm::vec2 gridStart{glm::max((viewBottomLeft - bottomLeft) / m_cellSize, -padding)};
+        const glm::vec2 gridEnd{glm::min((viewTopRight - bottomLeft) / m_cellSize, glm::vec2{m_gridSize} + padding)};
+
+        if (glm::any(glm::greaterThanEqual(gridStart, gridEnd))) {
+            return;
+        }
+
         const glm::mat4 transform{
-            glm::scale(glm::translate(glm::mat4{1.0f}, glm::vec3{bottomLeft(*this), layer()}), glm::vec3{1.0f})};
+            glm::scale(glm::translate(glm::mat4{1.0f}, glm::vec3{bottomLeft, layer()}), glm::vec3{m_cellSize, 1.0f})};
 
+        // The grid lines are drawn with their own shader, so draw the quads queued before them first.
+        graphics.spriteBatch->flush();
         m_shader.bind();
         m_shader.setUniform("color", glm::vec3{1.0f});
         m_shader.setUniform("projectionViewMatrix", projectionViewMatrix(graphics.camera));
         m_shader.setUniform("transform", transform);
-        m_vao.bind();
-        m_vbo.drawArrays(GL_LINES);
+        m_shader.setUniform("gridOffset", gridStart);
+        m_shader.setUniform("gridExtent", gridEnd - gridStart);
+        m_shader.setUniform("gridSize", m_gridSize);
+        m_shader.setUniform("lineWidth", m_lineWidth);
+        graphics.quad.render();
     }
 } // namespace TileEngine
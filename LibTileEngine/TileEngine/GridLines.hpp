@@ -1,5 +1,3 @@
-
-
 #ifndef LIBTILEENGINE_TILEENGINE_GRIDLINES_HPP
 #define LIBTILEENGINE_TILEENGINE_GRIDLINES_HPP
 
@@ -8,30 +6,41 @@
 #include <TileEngine/Camera.hpp>
 #include <TileEngine/Object.hpp>
 #include <TileEngine/Shader.hpp>
-#include <TileEngine/VertexArray.hpp>
-#include <TileEngine/VertexBuffer.hpp>
 
 namespace TileEngine {
     /// Draws 2D grid lines.
+    /// @note The lines are worked out per pixel in a shader over a single quad covering the visible part of the grid,
+    /// so the memory and draw cost do not depend on the size of the grid.
     class GridLines final : public Object {
     public:
         /// Create a grid lines object.
         /// @param size The width and height of the grid in tiles.
         /// @param cellSize The width and height of the cells in pixels.
-        GridLines(glm::ivec2 size, glm::vec2 cellSize);
+        /// @param lineWidth The width of the lines in screen pixels.
+        GridLines(glm::ivec2 size, glm::vec2 cellSize, float lineWidth = 1.0f);
 
         GridLines(GridLines&) = delete; // Prevent copy to avoid issues w/ OpenGL
 
+        /// Get the size of the grid.
+        /// @return The width and height of the grid in tiles.
+        [[nodiscard]] glm::ivec2 gridSize() const;
+
+        /// Change the size of the grid without moving its anchor point.
+        /// @param size The width and height of the grid in tiles.
+        void setGridSize(glm::ivec2 size);
+
         void update(float deltaTime, const InputState& inputState, const Camera& camera) override;
         void render(const Graphics& graphics) const override;
 
     private:
-        /// The vertex array object.
-        const VertexArray m_vao{};
-        /// The vertex buffer object.
-        VertexBuffer m_vbo{};
+        /// The width and height of the grid in tiles.
+        glm::ivec2 m_gridSize;
+        /// The width and height of the cells in pixels.
+        const glm::vec2 m_cellSize;
+        /// The width of the lines in screen pixels.
+        const float m_lineWidth;
         /// The shader for drawing grid lines.
-        const Shader m_shader{Shader::create("resource/shader/grid.vert", "resource/shader/grid.frag")};
+        const Shader m_shader{Shader::create("resource/shader/tile_id.vert", "resource/shader/grid.frag")};
     };
 
 } // namespace TileEngine
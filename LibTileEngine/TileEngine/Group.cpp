@@ -181,19 +181,13 @@ namespace TileEngine {
 
     void Group::render(const Graphics& graphics) const {
         if (m_style.fillColor.has_value()) {
-            graphics.quadShader.bind();
-            graphics.quadShader.setUniform("projectionViewMatrix", projectionViewMatrix(graphics.camera));
             glm::mat4 transform{glm::translate(glm::mat4{1.0f}, {bottomLeft(*this), layer()})};
             transform = glm::scale(transform, {size(), 1.0f});
-            graphics.quadShader.setUniform("transform", transform);
-            graphics.quadShader.setUniform("color", *m_style.fillColor);
-            graphics.quad.render();
+            graphics.spriteBatch->draw(graphics.camera, transform, *m_style.fillColor);
         }
 
         if (m_style.outline.has_value()) {
-            graphics.quadShader.bind();
-            graphics.quadShader.setUniform("projectionViewMatrix", projectionViewMatrix(graphics.camera));
-            Outline::draw(*this, graphics.quadShader, graphics.quad, *m_style.outline);
+            Outline::draw(*this, graphics, *m_style.outline);
         }
 
         for (const std::shared_ptr<Object>& object : children()) {
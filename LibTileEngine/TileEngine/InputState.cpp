@@ -186,6 +186,10 @@ namespace TileEngine {
         m_scrollDelta += static_cast<float>(scrollY);
     }
 
+    float InputState::scrollDelta() const {
+        return m_scrollDelta;
+    }
+
     const glm::vec2& InputState::mousePosition() const {
         return m_mousePosition;
     }
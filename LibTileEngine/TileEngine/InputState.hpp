@@ -53,6 +53,10 @@ namespace TileEngine {
         /// @return the movement of the mouse in pixels.
         [[nodiscard]] const glm::vec2& mouseMovement() const;
 
+        /// Get the scroll wheel movement since the last frame.
+        /// @return The number of vertical scroll steps, where positive values scroll up.
+        [[nodiscard]] float scrollDelta() const;
+
         /// Update the cumulative scroll wheel movement.
         /// @param scrollX The amount of horizontal scroll input.
         /// @param scrollY The amount of vertical scroll input.
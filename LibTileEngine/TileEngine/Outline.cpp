@@ -62,33 +62,27 @@ namespace TileEngine::Outline {
         }
 
         /// Draw one side of an outline.
-        /// @note Assumes the shader has the uniform variables "transform" (glm::mat4) and "color" (glm::vec3).
-        /// @note Assumes that the perspective/view matrices have already been set in the shader.
         /// @param object The GUI object to draw the outline around.
-        /// @param shader The shader to draw the outline with.
-        /// @param quad The quad geometry to use for drawing the outline.
+        /// @param graphics The camera and sprite batch to draw the outline with.
         /// @param outline The configuration for the outline appearance.
         /// @param rect: The area to fill.
-        void drawSide(const Object& object, const Shader& shader, const Quad& quad, const Style& outline,
-                      const Rect& rect) {
+        void drawSide(const Object& object, const Graphics& graphics, const Style& outline, const Rect& rect) {
             glm::mat4 transform = glm::translate(glm::mat4{1.0f}, {rect.bottomLeft, object.layer()});
             transform = glm::scale(transform, {rect.topRight - rect.bottomLeft, 1.0f});
-            shader.setUniform("transform", transform);
-            shader.setUniform("color", outline.color);
-            quad.render();
+            graphics.spriteBatch->draw(graphics.camera, transform, outline.color);
         }
     } // namespace
 
-    void draw(const Object& object, const Shader& shader, const Quad& quad, const Style& outline) {
+    void draw(const Object& object, const Graphics& graphics, const Style& outline) {
         if (outline.thickness < 1.0f) {
             return;
         }
 
         const auto [left, right, top, bottom]{getOutlineRectangles(object, outline)};
 
-        drawSide(object, shader, quad, outline, left);
-        drawSide(object, shader, quad, outline, right);
-        drawSide(object, shader, quad, outline, top);
-        drawSide(object, shader, quad, outline, bottom);
+        drawSide(object, graphics, outline, left);
+        drawSide(object, graphics, outline, right);
+        drawSide(object, graphics, outline, top);
+        drawSide(object, graphics, outline, bottom);
     }
 } // namespace TileEngine::Outline
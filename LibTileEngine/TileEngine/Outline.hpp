@@ -4,9 +4,8 @@
 #define LIBTILEENGINE_TILEENGINE_OUTLINE_HPP
 
 
+#include <TileEngine/Graphics.hpp>
 #include <TileEngine/Object.hpp>
-#include <TileEngine/Quad.hpp>
-#include <TileEngine/Shader.hpp>
 
 
 namespace TileEngine::Outline {
@@ -24,14 +23,12 @@ namespace TileEngine::Outline {
     };
 
     /// Draw an outline around a GUI object.
-    /// @note Assumes the shader has the uniform variables "transform" (glm::mat4) and "color" (glm::vec3).
-    /// @note Assumes that the perspective/view matrices have already been set in the shader.
+    /// @note The sides of the outline are added to the sprite batch, so they are drawn on the next flush.
     /// @note Does not draw anything if the outline thickness is less than one pixel.
     /// @param object The GUI object to draw the outline around.
-    /// @param shader The shader to draw the outline with.
-    /// @param quad The quad geometry to use for drawing the outline.
+    /// @param graphics The camera and sprite batch to draw the outline with.
     /// @param outline The configuration for the outline appearance.
-    void draw(const Object& object, const Shader& shader, const Quad& quad, const Style& outline);
+    void draw(const Object& object, const Graphics& graphics, const Style& outline);
 
 } // namespace TileEngine
 
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <limits>
+#include <utility>
+
+#include <TileEngine/PackedTiles.hpp>
+
+namespace TileEngine {
+    namespace {
+        /// The number of bits in a word of packed palette indices.
+        constexpr int wordBits{std::numeric_limits<std::uint64_t>::digits};
+    } // namespace
+
+    PackedTiles PackedTiles::pack(const std::span<const std::uint16_t> tiles) {
+        assert(!tiles.empty() and "Cannot pack an empty block of tiles.");
+
+        std::vector palette(tiles.begin(), tiles.end());
+        std::ranges::sort(palette);
+        const auto duplicates{std::ranges::unique(palette)};
+        palette.erase(duplicates.begin(), duplicates.end());
+        palette.shrink_to_fit();
+
+        // 1, 2, 4, 8 or 16 bits, so that every index sits within a single word.
+        const int indexBits{static_cast<int>(std::bit_width(palette.size() - 1))};
+        const int bitsPerTile{indexBits == 0 ? 0 : static_cast<int>(std::bit_ceil(static_cast<unsigned>(indexBits)))};
+
+        if (bitsPerTile == 0) {
+            return {tiles.size(), std::move(palette), 0, {}};
+        }
+
+        const int tilesPerWord{wordBits / bitsPerTile};
+        std::vector<std::uint64_t> words((tiles.size() + tilesPerWord - 1) / tilesPerWord, 0);
+
+        for (std::size_t i = 0; i < tiles.size(); ++i) {
+            const auto paletteIndex{std::ranges::lower_bound(palette, tiles[i]) - palette.begin()};
+            words[i / tilesPerWord] |= static_cast<std::uint64_t>(paletteIndex) << (i % tilesPerWord * bitsPerTile);
+        }
+
+        return {tiles.size(), std::move(palette), bitsPerTile, std::move(words)};
+    }
+
+    PackedTiles::PackedTiles(const std::size_t size, std::vector<std::uint16_t> palette, const int bitsPerTile,
+                             std::vector<std::uint64_t> words) :
+        m_size(size), m_palette(std::move(palette)), m_bitsPerTile(bitsPerTile), m_words(std::move(words)) {
+    }
+
+    std::size_t PackedTiles::size() const {
+        return m_size;
+    }
+
+    int PackedTiles::tileID(const std::size_t index) const {
+        assert(index < m_size and "Tile index out of range.");
+
+        return m_palette[paletteIndex(index)];
+    }
+
+    int PackedTiles::largestTileID() const {
+        return m_palette.back();
+    }
+
+    void PackedTiles::unpack(const std::span<std::uint16_t> tiles) const {
+        assert(tiles.size() == m_size and "There must be exactly one tile ID per packed tile.");
+
+        if (m_bitsPerTile == 0) {
+            std::ranges::fill(tiles, m_palette.front());
+            return;
+        }
+
+        // Unpack a word at a time rather than locating each tile's word.
+        const int tilesPerWord{wordBits / m_bitsPerTile};
+        const std::uint64_t indexMask{(std::uint64_t{1} << m_bitsPerTile) - 1};
+        std::size_t i{0};
+
+        for (std::uint64_t word : m_words) {
+            for (int j = 0; j < tilesPerWord and i < m_size; ++j, ++i) {
+                tiles[i] = m_palette[word & indexMask];
+                word >>= m_bitsPerTile;
+            }
+        }
+    }
+
+    std::size_t PackedTiles::byteSize() const {
+        return sizeof(PackedTiles) + m_palette.capacity() * sizeof(std::uint16_t) +
+               m_words.capacity() * sizeof(std::uint64_t);
+    }
+
+    std::size_t PackedTiles::paletteIndex(const std::size_t index) const {
+        if (m_bitsPerTile == 0) {
+            return 0;
+        }
+
+        const int tilesPerWord{wordBits / m_bitsPerTile};
+        const std::uint64_t indexMask{(std::uint64_t{1} << m_bitsPerTile) - 1};
+
+        return m_words[index / tilesPerWord] >> (index % tilesPerWord * m_bitsPerTile) & indexMask;
+    }
+} // namespace TileEngine
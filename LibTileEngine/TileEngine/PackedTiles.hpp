@@ -0,0 +1,63 @@
+#ifndef LIBTILEENGINE_TILEENGINE_PACKEDTILES_HPP
+#define LIBTILEENGINE_TILEENGINE_PACKEDTILES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace TileEngine {
+    /// A compressed, read-only block of tile IDs.
+    /// @note The tiles are stored as indices into a palette of the distinct tile IDs in the block, bit-packed with
+    /// the fewest bits that fit the palette (rounded up to a power of two so that no index straddles two words). A
+    /// block of a single tile ID, e.g., a chunk of all grass or all water, only stores its palette. Single tiles can be
+    /// read without unpacking the whole block.
+    class PackedTiles {
+    public:
+        /// Compress a block of tile IDs.
+        /// @param tiles The tile IDs.
+        /// @return The packed tiles.
+        static PackedTiles pack(std::span<const std::uint16_t> tiles);
+
+        /// Get the number of tiles in the block.
+        [[nodiscard]] std::size_t size() const;
+
+        /// Get a single tile ID without unpacking the other tiles.
+        /// @param index The index of the tile in the block.
+        /// @return The tile ID.
+        [[nodiscard]] int tileID(std::size_t index) const;
+
+        /// Get the largest tile ID in the block.
+        [[nodiscard]] int largestTileID() const;
+
+        /// Decompress the whole block.
+        /// @param tiles Where to write the tile IDs. Must hold exactly `size()` tile IDs.
+        void unpack(std::span<std::uint16_t> tiles) const;
+
+        /// Get the number of bytes the packed tiles take up, including the palette.
+        [[nodiscard]] std::size_t byteSize() const;
+
+    private:
+        /// @param size The number of tiles in the block.
+        /// @param palette The distinct tile IDs in the block in ascending order.
+        /// @param bitsPerTile The number of bits of each palette index.
+        /// @param words The bit-packed palette indices.
+        PackedTiles(std::size_t size, std::vector<std::uint16_t> palette, int bitsPerTile,
+                    std::vector<std::uint64_t> words);
+
+        /// Get the palette index of a tile.
+        /// @param index The index of the tile in the block.
+        [[nodiscard]] std::size_t paletteIndex(std::size_t index) const;
+
+        /// The number of tiles in the block.
+        std::size_t m_size;
+        /// The distinct tile IDs in the block in ascending order.
+        std::vector<std::uint16_t> m_palette;
+        /// The number of bits of each palette index, zero if the palette holds a single tile ID.
+        int m_bitsPerTile;
+        /// The bit-packed palette indices, starting from the least significant bit of the first word.
+        std::vector<std::uint64_t> m_words;
+    };
+} // namespace TileEngine
+
+#endif // LIBTILEENGINE_TILEENGINE_PACKEDTILES_HPP
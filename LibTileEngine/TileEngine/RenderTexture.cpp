@@ -0,0 +1,110 @@
+#include <array>
+#include <stdexcept>
+
+#include "glad/glad.h"
+
+#include <TileEngine/RenderTexture.hpp>
+
+namespace TileEngine {
+    std::unique_ptr<RenderTexture> RenderTexture::create(const glm::ivec2 resolution, const bool mipmaps,
+                                                         const bool repeat) {
+        int previousFramebuffer{};
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+        unsigned int textureID{};
+        glGenTextures(1, &textureID);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, resolution.x, resolution.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        unsigned int depthBufferID{};
+        glGenRenderbuffers(1, &depthBufferID);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthBufferID);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, resolution.x, resolution.y);
+
+        unsigned int framebufferID{};
+        glGenFramebuffers(1, &framebufferID);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureID, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBufferID);
+
+        const GLenum status{glCheckFramebufferStatus(GL_FRAMEBUFFER)};
+        glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+
+        // Wrap the IDs straight away so that they are freed if the framebuffer turns out to be unusable.
+        auto renderTexture{
+            std::make_unique<RenderTexture>(framebufferID, textureID, depthBufferID, resolution, mipmaps)};
+
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            throw std::runtime_error("Could not create a complete framebuffer for the render texture.");
+        }
+
+        return renderTexture;
+    }
+
+    RenderTexture::RenderTexture(const unsigned int framebufferID, const unsigned int textureID,
+                                 const unsigned int depthBufferID, const glm::ivec2 resolution, const bool mipmaps) :
+        m_framebufferID(framebufferID), m_textureID(textureID), m_depthBufferID(depthBufferID),
+        m_resolution(resolution), m_mipmaps(mipmaps) {
+    }
+
+    RenderTexture::~RenderTexture() {
+        glDeleteFramebuffers(1, &m_framebufferID);
+        glDeleteRenderbuffers(1, &m_depthBufferID);
+        glDeleteTextures(1, &m_textureID);
+    }
+
+    void RenderTexture::renderTo(const std::function<void()>& draw) const {
+        renderToRegion({0, 0}, m_resolution, draw);
+    }
+
+    void RenderTexture::renderToRegion(const glm::ivec2 start, const glm::ivec2 size,
+                                       const std::function<void()>& draw) const {
+        int previousFramebuffer{};
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        std::array<int, 4> previousViewport{};
+        glGetIntegerv(GL_VIEWPORT, previousViewport.data());
+        std::array<float, 4> previousClearColor{};
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, previousClearColor.data());
+        std::array<int, 4> previousScissorBox{};
+        glGetIntegerv(GL_SCISSOR_BOX, previousScissorBox.data());
+        const bool scissorTest{glIsEnabled(GL_SCISSOR_TEST) == GL_TRUE};
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferID);
+        glViewport(0, 0, m_resolution.x, m_resolution.y);
+        // The scissor test limits both the clear and the draw calls to the region.
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(start.x, start.y, size.x, size.y);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        draw();
+
+        glScissor(previousScissorBox[0], previousScissorBox[1], previousScissorBox[2], previousScissorBox[3]);
+
+        if (!scissorTest) {
+            glDisable(GL_SCISSOR_TEST);
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+        glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+        glClearColor(previousClearColor[0], previousClearColor[1], previousClearColor[2], previousClearColor[3]);
+
+        if (m_mipmaps) {
+            glBindTexture(GL_TEXTURE_2D, m_textureID);
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+    }
+
+    glm::ivec2 RenderTexture::resolution() const {
+        return m_resolution;
+    }
+
+    void RenderTexture::bind(const int textureUnit) const {
+        glActiveTexture(textureUnit);
+        glBindTexture(GL_TEXTURE_2D, m_textureID);
+    }
+} // namespace TileEngine
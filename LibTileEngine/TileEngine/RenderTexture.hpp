@@ -0,0 +1,68 @@
+#ifndef LIBTILEENGINE_TILEENGINE_RENDERTEXTURE_HPP
+#define LIBTILEENGINE_TILEENGINE_RENDERTEXTURE_HPP
+
+#include <functional>
+#include <memory>
+
+#include <glm/vec2.hpp>
+
+namespace TileEngine {
+
+    /// An offscreen RGBA texture with a depth buffer that can be drawn into and then sampled like any other texture.
+    class RenderTexture {
+    public:
+        /// Create an empty render texture.
+        /// @param resolution The width and height of the texture in pixels.
+        /// @param mipmaps Whether to keep a mipmap chain for sampling the texture at smaller sizes.
+        /// @param repeat Whether texture coordinates outside of [0, 1] wrap around instead of being clamped.
+        /// @return A render texture.
+        static std::unique_ptr<RenderTexture> create(glm::ivec2 resolution, bool mipmaps = true, bool repeat = false);
+
+        /// @param framebufferID The OpenGL ID for the framebuffer object.
+        /// @param textureID The OpenGL ID for the color texture.
+        /// @param depthBufferID The OpenGL ID for the depth renderbuffer.
+        /// @param resolution The width and height of the texture in pixels.
+        /// @param mipmaps Whether the texture has a mipmap chain.
+        RenderTexture(unsigned int framebufferID, unsigned int textureID, unsigned int depthBufferID,
+                      glm::ivec2 resolution, bool mipmaps);
+
+        // Prevent copy to avoid issues with textures being freed via destructor.
+        RenderTexture(RenderTexture&) = delete;
+
+        ~RenderTexture();
+
+        /// Clear the texture to transparent black and draw into it.
+        /// @note The previously bound framebuffer and viewport are restored afterwards and the mipmaps are regenerated.
+        /// @param draw A function that issues the draw calls.
+        void renderTo(const std::function<void()>& draw) const;
+
+        /// Clear a rectangular region of the texture to transparent black and draw into that region only.
+        /// @note The viewport still covers the whole texture, drawing outside of the region is discarded.
+        /// @param start The bottom left pixel of the region.
+        /// @param size The width and height of the region in pixels.
+        /// @param draw A function that issues the draw calls.
+        void renderToRegion(glm::ivec2 start, glm::ivec2 size, const std::function<void()>& draw) const;
+
+        /// Get the width and height of the texture in pixels.
+        [[nodiscard]] glm::ivec2 resolution() const;
+
+        /// Bind the texture for sampling.
+        /// @param textureUnit The texture unit to bind to, e.g., GL_TEXTURE0.
+        void bind(int textureUnit) const;
+
+    private:
+        /// The OpenGL ID for the framebuffer object.
+        const unsigned int m_framebufferID;
+        /// The OpenGL ID for the color texture.
+        const unsigned int m_textureID;
+        /// The OpenGL ID for the depth renderbuffer.
+        const unsigned int m_depthBufferID;
+        /// The width and height of the texture in pixels.
+        const glm::ivec2 m_resolution;
+        /// Whether the texture has a mipmap chain that must be regenerated after drawing.
+        const bool m_mipmaps;
+    };
+
+} // namespace TileEngine
+
+#endif // LIBTILEENGINE_TILEENGINE_RENDERTEXTURE_HPP
@@ -152,6 +152,10 @@ namespace TileEngine {
         glUniform2fv(uniformLocation(name), 1, value_ptr(value));
     }
 
+    void Shader::setUniform(const std::string& name, const glm::ivec2& value) const {
+        glUniform2iv(uniformLocation(name), 1, value_ptr(value));
+    }
+
     void Shader::setUniform(const std::string& name, const glm::mat4x4& value) const {
         glUniformMatrix4fv(uniformLocation(name), 1, GL_FALSE, value_ptr(value));
     }
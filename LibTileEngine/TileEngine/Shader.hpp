@@ -78,6 +78,11 @@ namespace TileEngine {
         /// @param value The value to set the uniform to.
         void setUniform(const std::string& name, const glm::vec2& value) const;
 
+        /// Set an integer 2-vector uniform value.
+        /// @param name The name of the uniform.
+        /// @param value The value to set the uniform to.
+        void setUniform(const std::string& name, const glm::ivec2& value) const;
+
         /// Set a 4x4 float matrix uniform value.
         /// @param name The name of the uniform.
         /// @param value The value to set the uniform to.
@@ -0,0 +1,101 @@
+#include <array>
+#include <utility>
+
+#include <TileEngine/SpriteBatch.hpp>
+
+namespace TileEngine {
+    namespace {
+        /// The number of floats per vertex: position (4), texture coordinates (2), colour (4) and whether the quad is
+        /// textured (1).
+        constexpr int vertexSize{11};
+        /// The number of vertices per quad, drawn as two triangles.
+        constexpr int quadVertexCount{6};
+    } // namespace
+
+    SpriteBatch::SpriteBatch() :
+        m_whiteTexture(Texture::create(
+            Image::Image{.bytes = {255, 255, 255, 255}, .resolution = {1, 1}, .channels = 4, .path = ""})) {
+        m_vertices.reserve(static_cast<std::size_t>(maxQuads) * quadVertexCount * vertexSize);
+    }
+
+    void SpriteBatch::draw(const Camera& camera, const glm::mat4& transform, const glm::vec4 color) {
+        addQuad(camera, transform, nullptr, color, glm::vec2{0.0f}, glm::vec2{1.0f});
+    }
+
+    void SpriteBatch::draw(const Camera& camera, const glm::mat4& transform, const Texture& texture,
+                           const glm::vec4 tint, const glm::vec2 textureCoordinatesMin,
+                           const glm::vec2 textureCoordinatesMax) {
+        addQuad(camera, transform, &texture, tint, textureCoordinatesMin, textureCoordinatesMax);
+    }
+
+    void SpriteBatch::drawText(const Font& font, const std::string_view text, const glm::vec3 position,
+                               const Anchor anchor, const Font::Style& style, const Camera& camera) {
+        m_text.push_back({&font, std::string{text}, position, anchor, style, &camera});
+    }
+
+    void SpriteBatch::flush() {
+        if (m_vertices.empty()) {
+            return;
+        }
+
+        const Texture& texture{m_texture != nullptr ? *m_texture : *m_whiteTexture};
+
+        m_shader.bind();
+        m_shader.setUniform("spriteTexture", texture.getUniformTextureUnit());
+        texture.bind();
+
+        m_vao.bind();
+        m_vbo.loadData(m_vertices, {4, 2, 4, 1}, GL_STREAM_DRAW);
+        m_vbo.drawArrays(GL_TRIANGLES);
+
+        m_vertices.clear();
+        m_texture = nullptr;
+        ++m_drawCallCount;
+    }
+
+    void SpriteBatch::flushText() {
+        flush();
+
+        for (const auto& [font, text, position, anchor, style, camera] : m_text) {
+            font->render(text, position, anchor, style, *camera);
+            ++m_drawCallCount;
+        }
+
+        m_text.clear();
+    }
+
+    int SpriteBatch::takeDrawCallCount() {
+        return std::exchange(m_drawCallCount, 0);
+    }
+
+    void SpriteBatch::addQuad(const Camera& camera, const glm::mat4& transform, const Texture* texture,
+                              const glm::vec4 color, const glm::vec2 textureCoordinatesMin,
+                              const glm::vec2 textureCoordinatesMax) {
+        // Coloured quads can join the quads of any texture, so only textured quads switch textures.
+        if (texture != nullptr and m_texture != nullptr and texture != m_texture) {
+            flush();
+        }
+
+        if (m_vertices.size() >= static_cast<std::size_t>(maxQuads) * quadVertexCount * vertexSize) {
+            flush();
+        }
+
+        if (texture != nullptr) {
+            m_texture = texture;
+        }
+
+        const float textured{texture != nullptr ? 1.0f : 0.0f};
+        const glm::mat4 clipTransform{projectionViewMatrix(camera) * transform};
+        const std::array<glm::vec2, 4> corners{glm::vec2{0.0f, 0.0f}, glm::vec2{1.0f, 0.0f}, glm::vec2{1.0f, 1.0f},
+                                               glm::vec2{0.0f, 1.0f}};
+
+        for (const int corner : {0, 1, 2, 0, 2, 3}) {
+            const glm::vec4 position{clipTransform * glm::vec4{corners[corner], 0.0f, 1.0f}};
+            const glm::vec2 textureCoordinates{textureCoordinatesMin +
+                                               (textureCoordinatesMax - textureCoordinatesMin) * corners[corner]};
+
+            m_vertices.insert(m_vertices.end(), {position.x, position.y, position.z, position.w, textureCoordinates.x,
+                                                 textureCoordinates.y, color.x, color.y, color.z, color.w, textured});
+        }
+    }
+} // namespace TileEngine
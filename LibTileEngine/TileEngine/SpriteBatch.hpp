@@ -0,0 +1,125 @@
+#ifndef LIBTILEENGINE_TILEENGINE_SPRITEBATCH_HPP
+#define LIBTILEENGINE_TILEENGINE_SPRITEBATCH_HPP
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
+
+#include <TileEngine/Anchor.hpp>
+#include <TileEngine/Camera.hpp>
+#include <TileEngine/Font.hpp>
+#include <TileEngine/Shader.hpp>
+#include <TileEngine/Texture.hpp>
+#include <TileEngine/VertexArray.hpp>
+#include <TileEngine/VertexBuffer.hpp>
+
+namespace TileEngine {
+    /// Collects coloured and textured quads and draws them together with as few draw calls as possible.
+    /// @note Quads are transformed on the CPU and appended to one vertex stream, which is drawn when the texture
+    /// changes, the stream is full, or `flush` is called. Anything drawn with another shader must call `flush` first
+    /// so that it is drawn on top of the quads that came before it.
+    /// @note Coloured quads ignore the texture, so they can share a draw call with quads of any texture.
+    /// @note Text is queued instead and drawn by `flushText` after all the quads of the frame, so labels do not split
+    /// the quads into separate draw calls. The depth test keeps text behind any quads on a higher layer.
+    class SpriteBatch {
+    public:
+        /// The most quads drawn with a single draw call.
+        static constexpr int maxQuads{4096};
+
+        /// Create an empty sprite batch.
+        SpriteBatch();
+
+        SpriteBatch(SpriteBatch&) = delete; // Prevent copy to avoid issues w/ OpenGL
+
+        /// Add a quad filled with a solid colour.
+        /// @param camera The camera to draw the quad with.
+        /// @param transform The transform from the unit quad (see `Quad`) to world coordinates.
+        /// @param color The RGBA colour of the quad.
+        void draw(const Camera& camera, const glm::mat4& transform, glm::vec4 color);
+
+        /// Add a textured quad.
+        /// @note Changing the texture from one quad to the next draws the quads collected so far.
+        /// @param camera The camera to draw the quad with.
+        /// @param transform The transform from the unit quad (see `Quad`) to world coordinates.
+        /// @param texture The texture to sample. It must outlive the next flush.
+        /// @param tint The colour to multiply the texture by.
+        /// @param textureCoordinatesMin The texture coordinates of the bottom left corner of the quad.
+        /// @param textureCoordinatesMax The texture coordinates of the top right corner of the quad.
+        void draw(const Camera& camera, const glm::mat4& transform, const Texture& texture,
+                  glm::vec4 tint = glm::vec4{1.0f}, glm::vec2 textureCoordinatesMin = glm::vec2{0.0f},
+                  glm::vec2 textureCoordinatesMax = glm::vec2{1.0f});
+
+        /// Queue text to draw with the next call to `flushText`.
+        /// @param font The font to draw the text with. It must outlive the next call to `flushText`.
+        /// @param text The text to draw.
+        /// @param position Where to draw the text, with the layer as the z-coordinate (see `Font::render`).
+        /// @param anchor The point on the text that the position refers to.
+        /// @param style The appearance of the text.
+        /// @param camera The camera to draw the text with. It must outlive the next call to `flushText`.
+        void drawText(const Font& font, std::string_view text, glm::vec3 position, Anchor anchor,
+                      const Font::Style& style, const Camera& camera);
+
+        /// Draw the quads collected so far.
+        void flush();
+
+        /// Draw the quads collected so far, followed by the queued text.
+        /// @note Call this once at the end of the frame, after everything else has been drawn.
+        void flushText();
+
+        /// Get the number of draw calls issued since the last call, e.g., to show once per frame.
+        /// @note Each label of text counts as one draw call.
+        [[nodiscard]] int takeDrawCallCount();
+
+    private:
+        /// Text waiting to be drawn by `flushText`.
+        struct QueuedText {
+            /// The font to draw the text with.
+            const Font* font;
+            /// The text to draw.
+            std::string text;
+            /// Where to draw the text, with the layer as the z-coordinate.
+            glm::vec3 position;
+            /// The point on the text that the position refers to.
+            Anchor anchor;
+            /// The appearance of the text.
+            Font::Style style;
+            /// The camera to draw the text with.
+            const Camera* camera;
+        };
+
+        /// Append a quad to the vertex stream.
+        /// @param camera The camera to draw the quad with.
+        /// @param transform The transform from the unit quad to world coordinates.
+        /// @param texture The texture to sample, or null to fill the quad with the colour.
+        /// @param color The colour to multiply the texture by.
+        /// @param textureCoordinatesMin The texture coordinates of the bottom left corner of the quad.
+        /// @param textureCoordinatesMax The texture coordinates of the top right corner of the quad.
+        void addQuad(const Camera& camera, const glm::mat4& transform, const Texture* texture, glm::vec4 color,
+                     glm::vec2 textureCoordinatesMin, glm::vec2 textureCoordinatesMax);
+
+        /// The shader that draws the vertex stream.
+        Shader m_shader{Shader::create("resource/shader/sprite.vert", "resource/shader/sprite.frag")};
+        /// A single white pixel, bound in place of a texture when every quad in the batch is coloured.
+        std::unique_ptr<Texture> m_whiteTexture;
+        /// The vertex array object for the vertex stream.
+        const VertexArray m_vao{};
+        /// The buffer the vertex stream is uploaded to when it is drawn.
+        VertexBuffer m_vbo{};
+        /// The vertices collected since the last flush: clip space position (4 floats), texture coordinates (2),
+        /// colour (4) and whether the quad is textured (1), with two triangles per quad.
+        std::vector<float> m_vertices{};
+        /// The texture of the textured quads collected since the last flush, or null if there are none.
+        const Texture* m_texture{nullptr};
+        /// The text queued since the last call to `flushText`.
+        std::vector<QueuedText> m_text{};
+        /// The number of draw calls issued since `takeDrawCallCount` was last called.
+        int m_drawCallCount{0};
+    };
+} // namespace TileEngine
+
+#endif // LIBTILEENGINE_TILEENGINE_SPRITEBATCH_HPP
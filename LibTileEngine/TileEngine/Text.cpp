@@ -27,6 +27,6 @@ namespace TileEngine {
     }
 
     void Text::render(const Graphics& graphics) const {
-        m_font->render(m_text, {position(), layer()}, anchor(), m_style, graphics.camera);
+        graphics.spriteBatch->drawText(*m_font, m_text, {position(), layer()}, anchor(), m_style, graphics.camera);
     }
 } // namespace TileEngine
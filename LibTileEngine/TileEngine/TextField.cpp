@@ -183,19 +183,14 @@ namespace TileEngine {
         const glm::mat4 transform{glm::scale(glm::translate(glm::mat4{1.0f}, glm::vec3{bottomLeft(*this), layer()}),
                                              glm::vec3{size(), 1.0f})};
 
-        graphics.quadShader.bind();
-        graphics.quadShader.setUniform("projectionViewMatrix", projectionViewMatrix(graphics.camera));
-        graphics.quadShader.setUniform("transform", transform);
-        graphics.quadShader.setUniform("color", glm::vec4{m_style.fillColor, 1.0f});
-
-        graphics.quad.render();
+        graphics.spriteBatch->draw(graphics.camera, transform, glm::vec4{m_style.fillColor, 1.0f});
 
         switch (m_state) {
         case State::active:
-            Outline::draw(*this, graphics.quadShader, graphics.quad, m_style.outlineActive);
+            Outline::draw(*this, graphics, m_style.outlineActive);
             break;
         case State::inactive:
-            Outline::draw(*this, graphics.quadShader, graphics.quad, m_style.outlineInactive);
+            Outline::draw(*this, graphics, m_style.outlineInactive);
             break;
         default:
             break;
@@ -65,6 +65,12 @@ namespace TileEngine {
         return m_resolution;
     }
 
+    void Texture::enableMipmaps(const int maxLevel) const {
+        glBindTexture(GL_TEXTURE_2D, m_textureID);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, maxLevel);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    }
+
     void Texture::bind() const {
         glActiveTexture(m_textureUnit);
         glBindTexture(GL_TEXTURE_2D, m_textureID);
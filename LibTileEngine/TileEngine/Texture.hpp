@@ -46,6 +46,10 @@ namespace TileEngine {
         /// Get the size (width, height) of the texture in pixels.
         [[nodiscard]] glm::ivec2 resolution() const;
 
+        /// Sample the texture with trilinear filtering instead of from the full-size texture only.
+        /// @param maxLevel The smallest mipmap level to sample, where level 0 is the full-size texture.
+        void enableMipmaps(int maxLevel) const;
+
         /// Activate the current texture for bind in rendering.
         void bind() const;
 
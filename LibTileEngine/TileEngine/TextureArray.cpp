@@ -1,39 +1,78 @@
 
 
+#include <format>
+#include <stdexcept>
+
 #include "glad/glad.h"
 
 #include <TileEngine/TextureArray.hpp>
 
 namespace TileEngine {
-    TextureArray::TextureArray(const unsigned int id) : m_id(id) {
+    TextureArray::TextureArray(const unsigned int id, const unsigned int format) : m_id(id), m_format(format) {
     }
 
     TextureArray::~TextureArray() {
         glDeleteTextures(1, &m_id);
     }
 
-    std::unique_ptr<TextureArray> TextureArray::create(const int depth, const glm::ivec2 resolution) {
+    std::unique_ptr<TextureArray> TextureArray::create(const int depth, const glm::ivec2 resolution,
+                                                       const int channels) {
+        int maxLayers{};
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+
+        if (depth > maxLayers) {
+            throw std::runtime_error(std::format(
+                "Texture array of depth {0} exceeds the maximum of {1} layers supported by the graphics driver.", depth,
+                maxLayers));
+        }
+
+        GLenum internalFormat;
+        GLenum format;
+
+        switch (channels) {
+        case 1:
+            internalFormat = GL_R8;
+            format = GL_RED;
+            break;
+        case 3:
+            internalFormat = GL_RGB8;
+            format = GL_RGB;
+            break;
+        case 4:
+            internalFormat = GL_RGBA8;
+            format = GL_RGBA;
+            break;
+        default:
+            throw std::runtime_error(std::format("Texture array does not support {0} channels.", channels));
+        }
+
         unsigned int textureArrayID;
         glGenTextures(1, &textureArrayID);
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D_ARRAY, textureArrayID);
-        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R8, resolution.x, resolution.y, depth, 0, GL_RED, GL_UNSIGNED_BYTE,
-                     nullptr);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, static_cast<int>(internalFormat), resolution.x, resolution.y, depth, 0,
+                     format, GL_UNSIGNED_BYTE, nullptr);
 
-        return std::make_unique<TextureArray>(textureArrayID);
+        return std::make_unique<TextureArray>(textureArrayID, format);
     }
 
     void TextureArray::bufferSubImage(const int zOffset, const glm::ivec2 bufferSize,
                                       const unsigned char* buffer) const {
         bind();
-        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, zOffset, bufferSize.x, bufferSize.y, 1, GL_RED, GL_UNSIGNED_BYTE,
-                        buffer);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, zOffset, bufferSize.x, bufferSize.y, 1, m_format,
+                        GL_UNSIGNED_BYTE, buffer);
         glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     }
 
+    void TextureArray::generateMipmaps() const {
+        bind();
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    }
+
     void TextureArray::bind() const {
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
@@ -10,35 +10,44 @@
 namespace TileEngine {
 
     /// A collection of textures stored in an OpenGL texture array.
-    /// @note Assumes single channel textures.
     class TextureArray {
     public:
         /// Create an empty texture array with the given depth and resolution.
         /// @param depth The depth of the texture array, i.e., how many sub textures the array holds.
         /// @param resolution The width and height of each sub texture in pixels.
+        /// @param channels The number of channels in each sub texture (1, 3 or 4).
+        /// @note Throws if the depth exceeds `GL_MAX_ARRAY_TEXTURE_LAYERS`.
         /// @return An empty texture array.
-        static std::unique_ptr<TextureArray> create(int depth, glm::ivec2 resolution);
+        static std::unique_ptr<TextureArray> create(int depth, glm::ivec2 resolution, int channels = 1);
 
         /// Create a texture array from an OpenGL ID.
         /// @param id The OpenGL ID for the texture array.
-        explicit TextureArray(unsigned int id);
+        /// @param format The OpenGL pixel format of the sub textures, e.g., `GL_RED`.
+        TextureArray(unsigned int id, unsigned int format);
 
-        TextureArray(TextureArray&) = delete; // Prevent copy to avoid issues with textures being freed via destructor.
+        // Prevent copy to avoid issues with textures being freed via destructor.
+        TextureArray(TextureArray&) = delete;
 
         ~TextureArray();
 
         /// Load a texture into the texture array.
         /// @param zOffset The "depth" or "index" of the sub texture.
         /// @param bufferSize The width and height of the buffer in pixels.
-        /// @param buffer The raw image buffer (single channel).
+        /// @param buffer The raw image buffer with the same number of channels as the texture array.
         void bufferSubImage(int zOffset, glm::ivec2 bufferSize, const unsigned char* buffer) const;
 
+        /// Generate mipmaps for every sub texture and use trilinear filtering when minifying.
+        /// @note Call this after all sub textures have been loaded.
+        void generateMipmaps() const;
+
         /// Bind the texture array for rendering.
         void bind() const;
 
     private:
         /// The OpenGL ID for the texture array.
         const unsigned int m_id{};
+        /// The OpenGL pixel format of the sub textures.
+        const unsigned int m_format{};
     };
 
 } // namespace TileEngine
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "glad/glad.h"
+
+#include <TileEngine/TileAnimationTable.hpp>
+
+namespace TileEngine {
+    namespace {
+        /// The largest tile ID that can be animated or used as an animation frame.
+        constexpr int maxTileID{std::numeric_limits<std::uint16_t>::max()};
+
+        /// Create a buffer texture.
+        /// @param data The texel data.
+        /// @param internalFormat The format of each texel, e.g., `GL_R16UI`.
+        /// @return The OpenGL IDs of the buffer and the texture.
+        template <typename TexelType>
+        std::pair<unsigned int, unsigned int> createBufferTexture(const std::vector<TexelType>& data,
+                                                                  const GLenum internalFormat) {
+            unsigned int bufferID{};
+            glGenBuffers(1, &bufferID);
+            glBindBuffer(GL_TEXTURE_BUFFER, bufferID);
+            glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(data.size() * sizeof(TexelType)), data.data(),
+                         GL_STATIC_DRAW);
+
+            unsigned int textureID{};
+            glGenTextures(1, &textureID);
+            glBindTexture(GL_TEXTURE_BUFFER, textureID);
+            glTexBuffer(GL_TEXTURE_BUFFER, internalFormat, bufferID);
+
+            glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+            return {bufferID, textureID};
+        }
+    } // namespace
+
+    std::unique_ptr<TileAnimationTable> TileAnimationTable::create(const std::vector<TileAnimation>& animations) {
+        int largestAnimatedTileID{0};
+
+        for (const auto& [tileID, frames, frameDuration] : animations) {
+            if (tileID <= 0 or tileID > maxTileID) {
+                throw std::runtime_error(std::format("Cannot animate tile {0}, tile IDs must be between 1 and {1}.",
+                                                     tileID, maxTileID));
+            }
+
+            if (frames.empty() or frameDuration <= 0.0f) {
+                throw std::runtime_error(
+                    std::format("The animation for tile {0} needs at least one frame and a positive frame duration.",
+                                tileID));
+            }
+
+            // The shaders draw whatever frame is current, so frame zero would sample outside of the tile sheet.
+            if (std::ranges::any_of(frames, [](const int frame) { return frame <= 0 or frame > maxTileID; })) {
+                throw std::runtime_error(
+                    std::format("The frames of the animation for tile {0} must be between 1 and {1}.", tileID,
+                                maxTileID));
+            }
+
+            largestAnimatedTileID = std::max(largestAnimatedTileID, tileID);
+        }
+
+        // Tiles without an animation have zero frames. The table always has at least one entry since buffer textures
+        // cannot be empty.
+        std::vector<std::uint32_t> table(4 * (largestAnimatedTileID + 1), 0);
+        std::vector<std::uint16_t> animationFrames{};
+
+        for (const auto& [tileID, frames, frameDuration] : animations) {
+            const int entry{4 * tileID};
+            table[entry] = static_cast<std::uint32_t>(animationFrames.size());
+            table[entry + 1] = static_cast<std::uint32_t>(frames.size());
+            table[entry + 2] = std::max(1u, static_cast<std::uint32_t>(std::lround(frameDuration * 1000.0f)));
+
+            animationFrames.insert(animationFrames.end(), frames.begin(), frames.end());
+        }
+
+        if (animationFrames.empty()) {
+            animationFrames.push_back(0);
+        }
+
+        const auto [tableBufferID, tableTextureID]{createBufferTexture(table, GL_RGBA32UI)};
+        const auto [framesBufferID, framesTextureID]{createBufferTexture(animationFrames, GL_R16UI)};
+
+        return std::make_unique<TileAnimationTable>(tableBufferID, tableTextureID, framesBufferID, framesTextureID);
+    }
+
+    TileAnimationTable::TileAnimationTable(const unsigned int tableBufferID, const unsigned int tableTextureID,
+                                           const unsigned int framesBufferID, const unsigned int framesTextureID) :
+        m_tableBufferID(tableBufferID), m_tableTextureID(tableTextureID), m_framesBufferID(framesBufferID),
+        m_framesTextureID(framesTextureID) {
+    }
+
+    TileAnimationTable::~TileAnimationTable() {
+        glDeleteTextures(1, &m_tableTextureID);
+        glDeleteTextures(1, &m_framesTextureID);
+        glDeleteBuffers(1, &m_tableBufferID);
+        glDeleteBuffers(1, &m_framesBufferID);
+    }
+
+    void TileAnimationTable::bind(const int tableTextureUnit, const int framesTextureUnit) const {
+        glActiveTexture(tableTextureUnit);
+        glBindTexture(GL_TEXTURE_BUFFER, m_tableTextureID);
+        glActiveTexture(framesTextureUnit);
+        glBindTexture(GL_TEXTURE_BUFFER, m_framesTextureID);
+    }
+} // namespace TileEngine
@@ -0,0 +1,59 @@
+#ifndef LIBTILEENGINE_TILEENGINE_TILEANIMATIONTABLE_HPP
+#define LIBTILEENGINE_TILEENGINE_TILEANIMATIONTABLE_HPP
+
+#include <memory>
+#include <vector>
+
+namespace TileEngine {
+    /// An animation that cycles a tile through a sequence of tiles.
+    struct TileAnimation {
+        /// The ID of the tile that is animated, i.e., the tile ID stored in the tile map.
+        int tileID;
+        /// The tile IDs to show, in order. Frames cannot be empty tiles (zero).
+        std::vector<int> frames;
+        /// How long each frame is shown for in seconds.
+        float frameDuration;
+    };
+
+    /// The tile animations of a tile map, stored on the GPU so that shaders can work out the current frame of an
+    /// animated tile from the time alone.
+    /// @note The table is stored in two buffer textures: `animationTable`, an unsigned integer `uvec4` per tile ID
+    /// holding the index of the first frame, the number of frames and the frame duration in milliseconds, and
+    /// `animationFrames`, the tile ID of every frame.
+    class TileAnimationTable {
+    public:
+        /// Upload tile animations to the GPU.
+        /// @param animations The tile animations, at most one per tile ID.
+        /// @return The animation table.
+        static std::unique_ptr<TileAnimationTable> create(const std::vector<TileAnimation>& animations);
+
+        /// @param tableBufferID The OpenGL ID for the buffer holding the animation table.
+        /// @param tableTextureID The OpenGL ID for the buffer texture of the animation table.
+        /// @param framesBufferID The OpenGL ID for the buffer holding the animation frames.
+        /// @param framesTextureID The OpenGL ID for the buffer texture of the animation frames.
+        TileAnimationTable(unsigned int tableBufferID, unsigned int tableTextureID, unsigned int framesBufferID,
+                           unsigned int framesTextureID);
+
+        // Prevent copy to avoid issues with textures being freed via destructor.
+        TileAnimationTable(TileAnimationTable&) = delete;
+
+        ~TileAnimationTable();
+
+        /// Bind the animation table and frames for rendering.
+        /// @param tableTextureUnit The texture unit for the animation table, e.g., GL_TEXTURE2.
+        /// @param framesTextureUnit The texture unit for the animation frames, e.g., GL_TEXTURE3.
+        void bind(int tableTextureUnit, int framesTextureUnit) const;
+
+    private:
+        /// The OpenGL ID for the buffer holding the animation table.
+        const unsigned int m_tableBufferID;
+        /// The OpenGL ID for the buffer texture of the animation table.
+        const unsigned int m_tableTextureID;
+        /// The OpenGL ID for the buffer holding the animation frames.
+        const unsigned int m_framesBufferID;
+        /// The OpenGL ID for the buffer texture of the animation frames.
+        const unsigned int m_framesTextureID;
+    };
+} // namespace TileEngine
+
+#endif // LIBTILEENGINE_TILEENGINE_TILEANIMATIONTABLE_HPP
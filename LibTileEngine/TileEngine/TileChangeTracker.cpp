@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "glm/common.hpp"
+
+#include <TileEngine/TileChangeTracker.hpp>
+
+namespace TileEngine {
+    namespace {
+        /// Get the smallest region that contains two regions.
+        TileRegion boundingBox(const TileRegion& a, const TileRegion& b) {
+            return {glm::min(a.start, b.start), glm::max(a.end, b.end)};
+        }
+    } // namespace
+
+    std::int64_t TileRegion::area() const {
+        const glm::i64vec2 size{end - start};
+
+        return size.x * size.y;
+    }
+
+    bool TileChanges::empty() const {
+        return regions.empty();
+    }
+
+    void TileChangeTracker::markChanged(const TileRegion& region, const int layer) {
+        assert(layer >= 0 and layer < 32 and "Layer index must fit in the layer bit mask.");
+
+        if (glm::any(glm::greaterThanEqual(region.start, region.end))) {
+            return;
+        }
+
+        addRegion(region);
+        m_pendingChanges.layers |= 1u << layer;
+
+        const glm::i64vec2 firstChunk{ChunkGrid::toChunkCoordinates(region.start)};
+        const glm::i64vec2 lastChunk{ChunkGrid::toChunkCoordinates(region.end - std::int64_t{1})};
+
+        for (std::int64_t chunkRow = firstChunk.y; chunkRow <= lastChunk.y; ++chunkRow) {
+            for (std::int64_t chunkCol = firstChunk.x; chunkCol <= lastChunk.x; ++chunkCol) {
+                const glm::i64vec2 chunkCoordinates{chunkCol, chunkRow};
+                ++m_chunkGenerations[chunkCoordinates];
+
+                if (m_pendingChunks.insert(chunkCoordinates).second) {
+                    m_pendingChanges.chunks.push_back(chunkCoordinates);
+                }
+            }
+        }
+    }
+
+    const TileChanges& TileChangeTracker::pendingChanges() const {
+        return m_pendingChanges;
+    }
+
+    std::uint64_t TileChangeTracker::chunkGeneration(const glm::i64vec2 chunkCoordinates) const {
+        const auto generation{m_chunkGenerations.find(chunkCoordinates)};
+
+        return generation == m_chunkGenerations.end() ? 0 : generation->second;
+    }
+
+    void TileChangeTracker::addListener(const ChangeListener& listener) {
+        m_listeners.push_back(listener);
+    }
+
+    void TileChangeTracker::flush() {
+        if (m_pendingChanges.empty()) {
+            return;
+        }
+
+        // Start the next batch before notifying so that changes made by listeners go into it.
+        const TileChanges changes{std::exchange(m_pendingChanges, {})};
+        m_pendingChunks.clear();
+
+        for (const auto& listener : m_listeners) {
+            listener(changes);
+        }
+    }
+
+    void TileChangeTracker::addRegion(TileRegion region) {
+        auto& regions{m_pendingChanges.regions};
+
+        // Merge with any rectangle whose bounding box with the new one covers no more tiles than the two do
+        // separately, i.e., rectangles that overlap or that line up and touch. Runs of tiles, such as those painted
+        // with a brush, then collapse into a few rectangles. Merging can make the rectangle overlap others, so repeat
+        // until nothing merges.
+        bool merged{true};
+
+        while (merged) {
+            merged = false;
+
+            for (auto existing = regions.begin(); existing != regions.end(); ++existing) {
+                const TileRegion combined{boundingBox(*existing, region)};
+
+                if (combined.area() <= existing->area() + region.area()) {
+                    region = combined;
+                    regions.erase(existing);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+
+        regions.push_back(region);
+
+        // Keep the cost of adding a rectangle bounded when many scattered tiles change.
+        if (regions.size() > maxRegions) {
+            TileRegion bounds{regions.front()};
+
+            for (const TileRegion& other : regions) {
+                bounds = boundingBox(bounds, other);
+            }
+
+            regions = {bounds};
+        }
+    }
+} // namespace TileEngine
@@ -0,0 +1,87 @@
+#ifndef LIBTILEENGINE_TILEENGINE_TILECHANGETRACKER_HPP
+#define LIBTILEENGINE_TILEENGINE_TILECHANGETRACKER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "glm/vec2.hpp"
+
+#include <TileEngine/TileStorage.hpp>
+
+namespace TileEngine {
+    /// A rectangle of tiles in grid coordinates.
+    struct TileRegion {
+        /// The bottom left corner of the region.
+        glm::i64vec2 start;
+        /// The tile after the top right corner of the region, i.e., the region is `[start, end)`.
+        glm::i64vec2 end;
+
+        /// Get the number of tiles in the region.
+        [[nodiscard]] std::int64_t area() const;
+    };
+
+    /// The changes made to a tile map since subscribers were last notified.
+    struct TileChanges {
+        /// Rectangles covering every changed tile. Neighbouring changes are merged, so the rectangles may also cover
+        /// some tiles that did not change.
+        std::vector<TileRegion> regions;
+        /// The coordinates of the chunks with changed tiles.
+        std::vector<glm::i64vec2> chunks;
+        /// A bit mask of the layers with changed tiles, where bit `i` is set if layer `i` changed.
+        std::uint32_t layers;
+
+        /// Whether nothing has changed.
+        [[nodiscard]] bool empty() const;
+    };
+
+    /// Collects the changes to the tiles of a tile map so that caches built on the map (e.g., minimaps, pathfinding
+    /// graphs, collision) can be updated incrementally.
+    /// @note Changes are batched and delivered to subscribers once per call to `flush`, rather than once per tile.
+    class TileChangeTracker {
+    public:
+        /// A function that is given the changes made since the last notification.
+        using ChangeListener = std::function<void(const TileChanges& changes)>;
+
+        /// The number of dirty rectangles kept before they are all merged into their bounding box.
+        static constexpr std::size_t maxRegions{64};
+
+        /// Record that the tiles in a region have changed.
+        /// @param region The changed region in grid coordinates.
+        /// @param layer The index of the layer that changed.
+        void markChanged(const TileRegion& region, int layer);
+
+        /// Get the changes recorded since subscribers were last notified.
+        [[nodiscard]] const TileChanges& pendingChanges() const;
+
+        /// Get how many times the tiles of a chunk have changed.
+        /// @param chunkCoordinates The coordinates of a chunk.
+        /// @return A number that increases every time a tile in the chunk changes, or zero if it never has.
+        [[nodiscard]] std::uint64_t chunkGeneration(glm::i64vec2 chunkCoordinates) const;
+
+        /// Register a callback for batched tile changes.
+        /// @param listener A function that is called with the changes made since the last notification.
+        void addListener(const ChangeListener& listener);
+
+        /// Notify the subscribers of the pending changes, if any, and start a new batch.
+        void flush();
+
+    private:
+        /// Add a dirty rectangle, merging it with the rectangles it overlaps or extends.
+        /// @param region The changed region in grid coordinates.
+        void addRegion(TileRegion region);
+
+        /// The changes recorded since subscribers were last notified.
+        TileChanges m_pendingChanges{};
+        /// The chunks in the pending changes, to avoid listing a chunk twice.
+        std::unordered_set<glm::i64vec2, ChunkCoordinatesHash> m_pendingChunks{};
+        /// The generation of every chunk that has changed.
+        std::unordered_map<glm::i64vec2, std::uint64_t, ChunkCoordinatesHash> m_chunkGenerations{};
+        /// Functions to be called with batched tile changes.
+        std::vector<ChangeListener> m_listeners{};
+    };
+} // namespace TileEngine
+
+#endif // LIBTILEENGINE_TILEENGINE_TILECHANGETRACKER_HPP
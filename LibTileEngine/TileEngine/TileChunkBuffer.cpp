@@ -0,0 +1,55 @@
+#include <cassert>
+
+#include <TileEngine/TileChunkBuffer.hpp>
+
+namespace TileEngine {
+    TileChunkBuffer::TileChunkBuffer() {
+        for (InstanceBatch* batch : {&m_opaque, &m_translucent}) {
+            batch->vao.bind();
+            batch->vertices.loadData({0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f}, {2});
+        }
+    }
+
+    std::uint32_t TileChunkBuffer::packInstance(const glm::ivec2 localCoordinates, const int layer, const int tileID) {
+        assert(localCoordinates.x >= 0 and localCoordinates.x < 64 and localCoordinates.y >= 0 and
+               localCoordinates.y < 64 and "Local tile coordinates must fit in six bits.");
+        assert(layer >= 0 and layer < 16 and "Tile layers must fit in four bits.");
+        assert(tileID > 0 and tileID <= maxTileID and "Tile IDs must fit in sixteen bits.");
+
+        return static_cast<std::uint32_t>(localCoordinates.x) | static_cast<std::uint32_t>(localCoordinates.y) << 6 |
+               static_cast<std::uint32_t>(layer) << 12 | static_cast<std::uint32_t>(tileID) << 16;
+    }
+
+    void TileChunkBuffer::loadInstanceData(const std::vector<std::uint32_t>& opaqueInstances,
+                                           const std::vector<std::uint32_t>& translucentInstances) {
+        m_opaque.load(opaqueInstances);
+        m_translucent.load(translucentInstances);
+    }
+
+    int TileChunkBuffer::instanceCount() const {
+        return m_opaque.instanceCount + m_translucent.instanceCount;
+    }
+
+    void TileChunkBuffer::renderOpaque() const {
+        m_opaque.render();
+    }
+
+    void TileChunkBuffer::renderTranslucent() const {
+        m_translucent.render();
+    }
+
+    void TileChunkBuffer::InstanceBatch::load(const std::vector<std::uint32_t>& instanceData) {
+        vao.bind();
+        instances.loadInstanceData(instanceData, {1}, 1);
+        instanceCount = static_cast<int>(instanceData.size());
+    }
+
+    void TileChunkBuffer::InstanceBatch::render() const {
+        if (instanceCount == 0) {
+            return;
+        }
+
+        vao.bind();
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, instanceCount);
+    }
+} // namespace TileEngine
@@ -0,0 +1,83 @@
+#ifndef LIBTILEENGINE_TILEENGINE_TILECHUNKBUFFER_HPP
+#define LIBTILEENGINE_TILEENGINE_TILECHUNKBUFFER_HPP
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <TileEngine/VertexArray.hpp>
+#include <TileEngine/VertexBuffer.hpp>
+
+namespace TileEngine {
+    /// The GPU resources for drawing one chunk of a tile map with one instanced draw call for its opaque tiles and one
+    /// for its translucent tiles.
+    /// @note The instance data persists between frames and only needs to be reloaded when the chunk's tiles change.
+    class TileChunkBuffer {
+    public:
+        /// The largest tile ID that fits in a packed instance.
+        static constexpr int maxTileID{std::numeric_limits<std::uint16_t>::max()};
+
+        /// Create an empty chunk buffer.
+        TileChunkBuffer();
+
+        TileChunkBuffer(TileChunkBuffer&) = delete; // Prevent copy to avoid issues w/ OpenGL
+
+        /// Pack a tile into the 32-bit instance format expected by the tile shader.
+        /// @note The column is stored in bits 0-5, the row in bits 6-11, the tile layer in bits 12-15 and the tile ID
+        /// in bits 16-31.
+        /// @param localCoordinates The coordinates (column, row) of the tile relative to the bottom left corner of the
+        /// chunk.
+        /// @param layer The index of the tile layer the tile belongs to.
+        /// @param tileID The ID of the tile.
+        /// @return The packed instance.
+        [[nodiscard]] static std::uint32_t packInstance(glm::ivec2 localCoordinates, int layer, int tileID);
+
+        /// Replace the instance data for the chunk.
+        /// @param opaqueInstances One packed instance (see `packInstance`) per tile that can be drawn without
+        /// blending, in the order they should be drawn.
+        /// @param translucentInstances One packed instance per tile that must be blended, in the order they should be
+        /// drawn.
+        void loadInstanceData(const std::vector<std::uint32_t>& opaqueInstances,
+                              const std::vector<std::uint32_t>& translucentInstances);
+
+        /// Get the number of tiles that will be drawn for this chunk.
+        [[nodiscard]] int instanceCount() const;
+
+        /// Draw the tiles in the chunk that can be drawn without blending.
+        /// @note Assumes the tile shader and tile sheet texture have already been bound.
+        void renderOpaque() const;
+
+        /// Draw the tiles in the chunk that must be blended.
+        /// @note Assumes the tile shader and tile sheet texture have already been bound.
+        void renderTranslucent() const;
+
+    private:
+        /// The buffers for one instanced draw call.
+        struct InstanceBatch {
+            /// The vertex array object.
+            const VertexArray vao{};
+            /// The unit quad geometry that each tile is drawn with.
+            VertexBuffer vertices{};
+            /// The per-tile instance data.
+            VertexBuffer instances{};
+            /// The number of tiles in the instance data.
+            int instanceCount{0};
+
+            /// Replace the instance data.
+            /// @param instanceData One packed instance per tile to draw.
+            void load(const std::vector<std::uint32_t>& instanceData);
+
+            /// Draw the tiles.
+            void render() const;
+        };
+
+        /// The tiles that are drawn without blending.
+        InstanceBatch m_opaque{};
+        /// The tiles that are drawn with blending.
+        InstanceBatch m_translucent{};
+    };
+} // namespace TileEngine
+
+#endif // LIBTILEENGINE_TILEENGINE_TILECHUNKBUFFER_HPP
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+
+#include "glad/glad.h"
+
+#include <TileEngine/TileIDTexture.hpp>
+
+namespace TileEngine {
+    std::unique_ptr<TileIDTexture> TileIDTexture::create(const glm::ivec2 mapSize, const int layerCount,
+                                                         const std::vector<int>& tiles) {
+        int maxTextureSize{};
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+
+        if (mapSize.x > maxTextureSize or mapSize.y > maxTextureSize) {
+            throw std::runtime_error(std::format("Tile map of size {0}x{1} exceeds the maximum texture size of {2}.",
+                                                 mapSize.x, mapSize.y, maxTextureSize));
+        }
+
+        assert(std::ranges::all_of(tiles, [](const int tileID) { return tileID >= 0 and tileID <= maxTileID; }) and
+               "Tile ID out of range for the tile ID texture.");
+        const std::vector<std::uint16_t> texels(tiles.begin(), tiles.end());
+
+        int unpackAlignment{};
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2); // Rows of 16-bit texels are not necessarily 4-byte aligned.
+
+        unsigned int textureID{};
+        glGenTextures(1, &textureID);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R16UI, mapSize.x, mapSize.y, layerCount, 0, GL_RED_INTEGER,
+                     GL_UNSIGNED_SHORT, texels.data());
+
+        // Integer textures cannot be filtered and the shader only ever reads them with `texelFetch`.
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment); // Restore unpack alignment.
+
+        return std::make_unique<TileIDTexture>(textureID, mapSize);
+    }
+
+    TileIDTexture::TileIDTexture(const unsigned int id, const glm::ivec2 resolution) :
+        m_id(id), m_resolution(resolution) {
+    }
+
+    TileIDTexture::~TileIDTexture() {
+        glDeleteTextures(1, &m_id);
+    }
+
+    glm::ivec2 TileIDTexture::resolution() const {
+        return m_resolution;
+    }
+
+    void TileIDTexture::setTileID(const glm::ivec2 gridCoordinates, const int layer, const int tileID) const {
+        assert(tileID >= 0 and tileID <= maxTileID and "Tile ID out of range for the tile ID texture.");
+        const auto texel{static_cast<std::uint16_t>(tileID)};
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, gridCoordinates.x, gridCoordinates.y, layer, 1, 1, 1, GL_RED_INTEGER,
+                        GL_UNSIGNED_SHORT, &texel);
+    }
+
+    void TileIDTexture::setTiles(const glm::ivec2 start, const glm::ivec2 size, const int layer,
+                                 const std::vector<int>& tiles) const {
+        assert(std::ranges::all_of(tiles, [](const int tileID) { return tileID >= 0 and tileID <= maxTileID; }) and
+               "Tile ID out of range for the tile ID texture.");
+        const std::vector<std::uint16_t> texels(tiles.begin(), tiles.end());
+
+        int unpackAlignment{};
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2); // Rows of 16-bit texels are not necessarily 4-byte aligned.
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, start.x, start.y, layer, size.x, size.y, 1, GL_RED_INTEGER,
+                        GL_UNSIGNED_SHORT, texels.data());
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment); // Restore unpack alignment.
+    }
+
+    void TileIDTexture::bind(const int textureUnit) const {
+        glActiveTexture(textureUnit);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+    }
+} // namespace TileEngine
@@ -0,0 +1,64 @@
+#ifndef LIBTILEENGINE_TILEENGINE_TILEIDTEXTURE_HPP
+#define LIBTILEENGINE_TILEENGINE_TILEIDTEXTURE_HPP
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+namespace TileEngine {
+    /// An unsigned integer texture array that stores one tile ID per texel, and one tile layer per array layer, so that
+    /// tiles can be looked up in a fragment shader.
+    /// @note Tile IDs are stored with 16 bits, so IDs must be at most `maxTileID`.
+    class TileIDTexture {
+    public:
+        /// The largest tile ID a texel can hold.
+        static constexpr int maxTileID{std::numeric_limits<std::uint16_t>::max()};
+
+        /// Create a tile ID texture from the tiles of a tile map.
+        /// @param mapSize The size (width, height) of the tile map in tiles.
+        /// @param layerCount The number of tile layers.
+        /// @param tiles The tile IDs of each layer (bottom layer first) in row-major order.
+        /// @return A tile ID texture with one texel per tile.
+        static std::unique_ptr<TileIDTexture> create(glm::ivec2 mapSize, int layerCount, const std::vector<int>& tiles);
+
+        /// @param id The OpenGL ID for the texture.
+        /// @param resolution The width and height of the texture in texels.
+        TileIDTexture(unsigned int id, glm::ivec2 resolution);
+
+        // Prevent copy to avoid issues with textures being freed via destructor.
+        TileIDTexture(TileIDTexture&) = delete;
+
+        ~TileIDTexture();
+
+        /// Get the size (width, height) of the texture in texels.
+        [[nodiscard]] glm::ivec2 resolution() const;
+
+        /// Overwrite the tile ID of a single texel.
+        /// @param gridCoordinates The coordinates (column, row) of the tile.
+        /// @param layer The index of the tile layer.
+        /// @param tileID The new tile ID.
+        void setTileID(glm::ivec2 gridCoordinates, int layer, int tileID) const;
+
+        /// Overwrite the tile IDs of a rectangular region of texels with a single upload.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param size The size (width, height) of the region in tiles.
+        /// @param layer The index of the tile layer.
+        /// @param tiles The new tile IDs of the region in row-major order.
+        void setTiles(glm::ivec2 start, glm::ivec2 size, int layer, const std::vector<int>& tiles) const;
+
+        /// Bind the texture for rendering.
+        /// @param textureUnit The texture unit to bind the texture to, e.g., GL_TEXTURE1.
+        void bind(int textureUnit) const;
+
+    private:
+        /// The OpenGL ID for the texture.
+        const unsigned int m_id;
+        /// The width and height of the texture in texels.
+        const glm::ivec2 m_resolution;
+    };
+} // namespace TileEngine
+
+#endif // LIBTILEENGINE_TILEENGINE_TILEIDTEXTURE_HPP
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cassert>
+#include <ranges>
+
+#include <TileEngine/TileIndex.hpp>
+
+namespace TileEngine {
+    void TileIndex::addTile(const glm::i64vec2 chunkCoordinates, const int tileID) {
+        addTiles(chunkCoordinates, tileID, 1);
+    }
+
+    void TileIndex::removeTile(const glm::i64vec2 chunkCoordinates, const int tileID) {
+        removeTiles(chunkCoordinates, tileID, 1);
+    }
+
+    void TileIndex::addTiles(const glm::i64vec2 chunkCoordinates, const int tileID, const int tileCount) {
+        assert(tileCount >= 0 and "Cannot add a negative number of tiles.");
+
+        if (tileID == 0 or tileCount == 0) {
+            return;
+        }
+
+        TileUsage& usage{m_usage[tileID]};
+        usage.count += tileCount;
+        usage.chunkCounts[chunkCoordinates] += tileCount;
+    }
+
+    void TileIndex::removeTiles(const glm::i64vec2 chunkCoordinates, const int tileID, const int tileCount) {
+        assert(tileCount >= 0 and "Cannot remove a negative number of tiles.");
+
+        if (tileID == 0 or tileCount == 0) {
+            return;
+        }
+
+        const auto usage{m_usage.find(tileID)};
+        assert(usage != m_usage.end() and "Cannot remove a tile ID that is not in the index.");
+
+        const auto chunkCount{usage->second.chunkCounts.find(chunkCoordinates)};
+        assert(chunkCount != usage->second.chunkCounts.end() and chunkCount->second >= tileCount and
+               "Cannot remove more tiles from a chunk than it has.");
+
+        if ((chunkCount->second -= tileCount) == 0) {
+            usage->second.chunkCounts.erase(chunkCount);
+        }
+
+        if ((usage->second.count -= tileCount) == 0) {
+            m_usage.erase(usage);
+        }
+    }
+
+    void TileIndex::addChunk(const glm::i64vec2 chunkCoordinates, const std::vector<int>& tiles) {
+        for (const int tileID : tiles) {
+            addTile(chunkCoordinates, tileID);
+        }
+    }
+
+    void TileIndex::removeChunk(const glm::i64vec2 chunkCoordinates, const std::vector<int>& tiles) {
+        for (const int tileID : tiles) {
+            removeTile(chunkCoordinates, tileID);
+        }
+    }
+
+    std::int64_t TileIndex::count(const int tileID) const {
+        const auto usage{m_usage.find(tileID)};
+
+        return usage == m_usage.end() ? 0 : usage->second.count;
+    }
+
+    std::vector<glm::i64vec2> TileIndex::chunksWith(const int tileID) const {
+        const auto usage{m_usage.find(tileID)};
+
+        if (usage == m_usage.end()) {
+            return {};
+        }
+
+        const auto chunks{usage->second.chunkCounts | std::views::keys};
+
+        return {chunks.begin(), chunks.end()};
+    }
+
+    std::vector<std::pair<int, std::int64_t>> TileIndex::histogram() const {
+        std::vector<std::pair<int, std::int64_t>> tileCounts{};
+        tileCounts.reserve(m_usage.size());
+
+        for (const auto& [tileID, usage] : m_usage) {
+            tileCounts.emplace_back(tileID, usage.count);
+        }
+
+        std::ranges::sort(tileCounts);
+
+        return tileCounts;
+    }
+} // namespace TileEngine
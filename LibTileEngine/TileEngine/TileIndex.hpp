@@ -0,0 +1,80 @@
+#ifndef LIBTILEENGINE_TILEENGINE_TILEINDEX_HPP
+#define LIBTILEENGINE_TILEENGINE_TILEINDEX_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "glm/vec2.hpp"
+
+#include <TileEngine/TileStorage.hpp>
+
+namespace TileEngine {
+    /// An inverted index from tile IDs to where they are used in a tile layer.
+    /// @note For every tile ID the index keeps the total number of tiles and the number of tiles in each chunk that
+    /// uses it. Queries for one tile ID then only look at the chunks that contain it, rather than at the whole layer.
+    /// Empty tiles are not indexed.
+    class TileIndex {
+    public:
+        /// Record that a tile now uses a tile ID.
+        /// @param chunkCoordinates The coordinates of the chunk the tile is in.
+        /// @param tileID The tile ID. Zero is ignored.
+        void addTile(glm::i64vec2 chunkCoordinates, int tileID);
+
+        /// Record that a tile no longer uses a tile ID.
+        /// @param chunkCoordinates The coordinates of the chunk the tile is in.
+        /// @param tileID The tile ID. Zero is ignored.
+        void removeTile(glm::i64vec2 chunkCoordinates, int tileID);
+
+        /// Record that several tiles of a chunk now use a tile ID.
+        /// @param chunkCoordinates The coordinates of the chunk the tiles are in.
+        /// @param tileID The tile ID. Zero is ignored.
+        /// @param tileCount The number of tiles.
+        void addTiles(glm::i64vec2 chunkCoordinates, int tileID, int tileCount);
+
+        /// Record that several tiles of a chunk no longer use a tile ID.
+        /// @param chunkCoordinates The coordinates of the chunk the tiles are in.
+        /// @param tileID The tile ID. Zero is ignored.
+        /// @param tileCount The number of tiles.
+        void removeTiles(glm::i64vec2 chunkCoordinates, int tileID, int tileCount);
+
+        /// Record every tile of a chunk.
+        /// @param chunkCoordinates The coordinates of the chunk.
+        /// @param tiles The tile IDs of the chunk.
+        void addChunk(glm::i64vec2 chunkCoordinates, const std::vector<int>& tiles);
+
+        /// Forget every tile of a chunk.
+        /// @param chunkCoordinates The coordinates of the chunk.
+        /// @param tiles The tile IDs of the chunk, as they were added.
+        void removeChunk(glm::i64vec2 chunkCoordinates, const std::vector<int>& tiles);
+
+        /// Get the number of tiles that use a tile ID.
+        /// @param tileID A non-zero tile ID.
+        [[nodiscard]] std::int64_t count(int tileID) const;
+
+        /// Get the chunks that contain a tile ID.
+        /// @param tileID A non-zero tile ID.
+        /// @return The coordinates of the chunks in no particular order.
+        [[nodiscard]] std::vector<glm::i64vec2> chunksWith(int tileID) const;
+
+        /// Get how often each tile ID is used.
+        /// @return Pairs of tile IDs and the number of tiles that use them, sorted by tile ID. Tile IDs that are not
+        /// used are left out.
+        [[nodiscard]] std::vector<std::pair<int, std::int64_t>> histogram() const;
+
+    private:
+        /// Where one tile ID is used.
+        struct TileUsage {
+            /// The number of tiles that use the tile ID.
+            std::int64_t count{0};
+            /// The number of tiles that use the tile ID in each chunk that contains it.
+            std::unordered_map<glm::i64vec2, int, ChunkCoordinatesHash> chunkCounts{};
+        };
+
+        /// The usage of each tile ID that is used at least once.
+        std::unordered_map<int, TileUsage> m_usage{};
+    };
+} // namespace TileEngine
+
+#endif // LIBTILEENGINE_TILEENGINE_TILEINDEX_HPP
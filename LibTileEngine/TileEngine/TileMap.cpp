@@ -1,9 +1,20 @@
 
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
 #include <format>
+#include <functional>
 #include <iostream>
+#include <ranges>
+#include <limits>
+#include <span>
+#include <stdexcept>
 #include <utility>
 
+#include "glm/ext/matrix_clip_space.hpp"
 #include "glm/ext/matrix_transform.hpp"
 #include "yaml-cpp/yaml.h"
 
@@ -13,60 +24,261 @@
 
 namespace TileEngine {
     namespace {
-        /// Resize a tile map.
-        /// @param oldTiles The tiles in the old tile map.
-        /// @param oldSize The width and height of the old tile map in tiles.
-        /// @param newSize The width and height of the new tile map in tiles.
-        /// @return The tiles in the new tile map, with newly added tiles being set to zero (empty).
-        std::vector<int> resizeTileMap(const std::vector<int>& oldTiles, const glm::ivec2 oldSize,
-                                       const glm::ivec2 newSize) {
-            std::vector<int> newTiles(newSize.x * newSize.y);
-
-            const int colCount{std::min(oldSize.x, newSize.x)};
-            const int rowCount{std::min(oldSize.y, newSize.y)};
-
-            for (int row = 0; row < rowCount; ++row) {
-                for (int col = 0; col < colCount; ++col) {
-                    const int oldIndex{row * oldSize.x + col};
-                    const int newIndex{row * newSize.x + col};
-                    newTiles.at(newIndex) = oldTiles.at(oldIndex);
+        /// The distance along the z-axis between consecutive tile layers.
+        /// @note This is small enough that all tile layers are drawn below objects on the next object layer.
+        constexpr float layerDepthSpacing{0.01f};
+        /// The texture unit for the table of tile animations.
+        constexpr int animationTableTextureUnit{GL_TEXTURE2};
+        /// The texture unit for the frames of tile animations.
+        constexpr int animationFramesTextureUnit{GL_TEXTURE3};
+        /// Below this camera zoom level, chunks are drawn from baked textures instead of tile by tile.
+        constexpr float chunkDetailZoom{0.5f};
+        /// Below this camera zoom level, chunk groups are drawn from baked textures instead of chunk by chunk.
+        /// @note Chunk groups are baked at the same resolution as chunks, so they switch in at the zoom level where
+        /// they have as many pixels per tile as a baked chunk at `chunkDetailZoom`.
+        constexpr float chunkGroupDetailZoom{chunkDetailZoom / ChunkGrid::chunkGroupSize};
+        /// The most baked textures to keep for each detail level. The ones out of view are released to make room for
+        /// new ones, and visible chunks beyond the limit are drawn tile by tile.
+        constexpr std::size_t maxBakedTextures{256};
+        /// The most chunks or chunk groups to bake per update, so that zooming out spreads the baking over a few
+        /// frames instead of stalling on one.
+        constexpr std::size_t maxBakesPerUpdate{16};
+        /// How often to look for chunks to compress in seconds, see `TileMap::setChunkMemoryBudget`.
+        constexpr double chunkCompressionInterval{1.0};
+        /// The number of extra rows and columns of tiles the scroll buffer holds beyond what the camera can see.
+        constexpr int scrollBufferMargin{4};
+
+        /// Get how far the tiles of a map move when it is resized.
+        /// @param sizeChange The change in map size in tiles.
+        /// @param anchor The point of the map that stays in place.
+        /// @return The offset (columns, rows) to move the tiles by.
+        glm::i64vec2 resizeOffset(const glm::i64vec2 sizeChange, const Anchor anchor) {
+            switch (anchor) {
+            case Anchor::bottomLeft:
+                return {0, 0};
+            case Anchor::bottomRight:
+                return {sizeChange.x, 0};
+            case Anchor::topLeft:
+                return {0, sizeChange.y};
+            case Anchor::topRight:
+                return sizeChange;
+            case Anchor::center:
+                return sizeChange / std::int64_t{2};
+            }
+
+            return {0, 0};
+        }
+
+        /// Saves the blend and depth test state when it is created and restores it when it is destroyed, so that the
+        /// tile map can change the state while drawing without affecting whatever is drawn after it.
+        class BlendStateGuard {
+        public:
+            BlendStateGuard() :
+                m_blend(glIsEnabled(GL_BLEND) == GL_TRUE), m_depthTest(glIsEnabled(GL_DEPTH_TEST) == GL_TRUE) {
+                glGetIntegerv(GL_BLEND_SRC_RGB, &m_blendFunction[0]);
+                glGetIntegerv(GL_BLEND_DST_RGB, &m_blendFunction[1]);
+                glGetIntegerv(GL_BLEND_SRC_ALPHA, &m_blendFunction[2]);
+                glGetIntegerv(GL_BLEND_DST_ALPHA, &m_blendFunction[3]);
+            }
+
+            // Prevent copy so that the state is only restored once.
+            BlendStateGuard(BlendStateGuard&) = delete;
+
+            ~BlendStateGuard() {
+                glBlendFuncSeparate(m_blendFunction[0], m_blendFunction[1], m_blendFunction[2], m_blendFunction[3]);
+
+                if (m_blend) {
+                    glEnable(GL_BLEND);
+                } else {
+                    glDisable(GL_BLEND);
+                }
+
+                if (m_depthTest) {
+                    glEnable(GL_DEPTH_TEST);
+                } else {
+                    glDisable(GL_DEPTH_TEST);
                 }
             }
 
-            return newTiles;
+        private:
+            /// The source and destination factors of the colour and alpha channels.
+            std::array<int, 4> m_blendFunction{};
+            /// Whether blending was enabled.
+            bool m_blend;
+            /// Whether the depth test was enabled.
+            bool m_depthTest;
+        };
+
+        /// Draw tiles into an offscreen texture that starts out transparent.
+        /// @note The alpha channel is blended additively, so the texture ends up with premultiplied alpha. The blend
+        /// state and depth test are restored afterwards.
+        /// @param draw A function that issues the draw calls.
+        void drawOffscreen(const std::function<void()>& draw) {
+            const BlendStateGuard blendState{};
+
+            glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            glEnable(GL_DEPTH_TEST);
+
+            draw();
         }
-    }
+
+        /// Get the remainder of a division that is always positive, so that negative grid coordinates wrap around.
+        int wrap(const std::int64_t value, const int divisor) {
+            return static_cast<int>((value % divisor + divisor) % divisor);
+        }
+    } // namespace
 
     std::unique_ptr<TileMap> TileMap::create(const std::string& yamlPath) {
         const YAML::Node tileMapConfig{YAML::LoadFile(yamlPath)};
         const YAML::Node tileSheetNode{tileMapConfig["tile-sheet"]};
 
-        const auto texturePath{tileSheetNode["path"].as<std::string>()};
-        std::unique_ptr texture{Texture::create(texturePath)};
-
         const YAML::Node tileSizeNode{tileSheetNode["tile-size"]};
         // ReSharper disable once CppTemplateArgumentsCanBeDeduced
         const glm::vec2 tileSize{tileSizeNode["width"].as<int>(), tileSizeNode["height"].as<int>()};
 
+        std::unique_ptr<TileSheet> tileSheet{};
+
+        // Several tile sheet images can only be combined with a texture array, where tile IDs continue from one image
+        // to the next in the order the paths are listed.
+        if (const YAML::Node pathsNode{tileSheetNode["paths"]}) {
+            std::vector<Image::Image> images{};
+
+            for (const auto& pathNode : pathsNode) {
+                images.push_back(Image::create(pathNode.as<std::string>()));
+            }
+
+            tileSheet = TileSheet::createTextureArray(images, tileSize);
+        } else {
+            const auto texturePath{tileSheetNode["path"].as<std::string>()};
+            const YAML::Node textureArrayNode{tileSheetNode["texture-array"]};
+            const YAML::Node mipmapsNode{tileSheetNode["mipmaps"]};
+
+            // Tiles in a texture array cannot bleed into each other, so only a single texture needs padding to be
+            // mipmapped.
+            if (textureArrayNode and textureArrayNode.as<bool>()) {
+                tileSheet = TileSheet::createTextureArray(Image::create(texturePath), tileSize);
+            } else if (mipmapsNode and mipmapsNode.as<bool>()) {
+                tileSheet = TileSheet::createMipmapped(Image::create(texturePath), tileSize);
+            } else {
+                tileSheet = TileSheet::create(Image::create(texturePath), tileSize);
+            }
+        }
+
         const YAML::Node tileMapNode{tileMapConfig["tile-map"]};
         // ReSharper disable once CppTemplateArgumentsCanBeDeduced
         const glm::ivec2 tileMapSize{tileMapNode["width"].as<int>(), tileMapNode["height"].as<int>()};
-        const auto tiles{tileMapNode["tiles"].as<std::vector<int>>()};
 
-        auto tileSheet{std::make_unique<TileSheet>(std::move(texture), tileSize)};
+        std::vector<TileAnimation> animations{};
+
+        for (const auto& animationNode : tileMapNode["animations"]) {
+            animations.push_back({.tileID = animationNode["tile"].as<int>(),
+                                  .frames = animationNode["frames"].as<std::vector<int>>(),
+                                  .frameDuration = animationNode["frame-duration"].as<float>()});
+        }
+
+        const YAML::Node layersNode{tileMapNode["layers"]};
+
+        // Maps with a single layer may list their tiles directly under the tile map.
+        if (!layersNode) {
+            const auto tiles{tileMapNode["tiles"].as<std::vector<int>>()};
+            auto tileMap{std::make_unique<TileMap>(std::move(tileSheet), tileMapSize, tiles)};
+            tileMap->setAnimations(animations);
 
-        return std::make_unique<TileMap>(std::move(tileSheet), tileMapSize, tiles);
+            return tileMap;
+        }
+
+        std::vector<int> tiles{};
+
+        for (const auto& layerNode : layersNode) {
+            const auto layerTiles{layerNode["tiles"].as<std::vector<int>>()};
+            tiles.insert(tiles.end(), layerTiles.begin(), layerTiles.end());
+        }
+
+        auto tileMap{std::make_unique<TileMap>(std::move(tileSheet), tileMapSize, static_cast<int>(layersNode.size()),
+                                               tiles)};
+        int layer{0};
+
+        for (const auto& layerNode : layersNode) {
+            if (const YAML::Node visibleNode{layerNode["visible"]}) {
+                tileMap->setLayerVisible(layer, visibleNode.as<bool>());
+            }
+
+            if (const YAML::Node opacityNode{layerNode["opacity"]}) {
+                tileMap->setLayerOpacity(layer, opacityNode.as<float>());
+            }
+
+            ++layer;
+        }
+
+        tileMap->setAnimations(animations);
+
+        return tileMap;
     }
 
     TileMap::TileMap(std::unique_ptr<TileSheet> tileSheet, const glm::ivec2 mapSize, const std::vector<int>& tiles) :
-        m_tileSheet(std::move(tileSheet)), m_mapSize(mapSize), m_tiles(tiles) {
+        TileMap(std::move(tileSheet), mapSize, 1, tiles) {
+    }
+
+    TileMap::TileMap(std::unique_ptr<TileSheet> tileSheet, const glm::ivec2 mapSize, const int layerCount,
+                     const std::vector<int>& tiles) :
+        m_tileSheet(std::move(tileSheet)), m_mapSize(mapSize),
+        m_shader(Shader::create("resource/shader/tile.vert", m_tileSheet->usesTextureArray()
+                                                                 ? "resource/shader/tile_array.frag"
+                                                                 : "resource/shader/tile.frag")),
+        m_tileIDShader(Shader::create("resource/shader/tile_id.vert", m_tileSheet->usesTextureArray()
+                                                                          ? "resource/shader/tile_id_array.frag"
+                                                                          : "resource/shader/tile_id.frag")),
+        m_bakedTilesShader(Shader::create("resource/shader/baked_tiles.vert", "resource/shader/baked_tiles.frag")),
+        m_scrollBufferShader(Shader::create("resource/shader/tile_id.vert", "resource/shader/scroll_buffer.frag")) {
+        assert(layerCount > 0 and layerCount <= maxLayers and
+               "Tile maps must have between one and `maxLayers` layers.");
+        assert(static_cast<int>(tiles.size()) == layerCount * mapSize.x * mapSize.y and
+               "There must be exactly one tile ID per tile in every layer.");
+
+        // Tile IDs are packed into 16 bits for the tile shader, so larger IDs cannot be drawn.
+        if (m_tileSheet->tileCount() > TileChunkBuffer::maxTileID) {
+            throw std::runtime_error(std::format("The tile sheet has {0} tiles, but tile maps support at most {1}.",
+                                                 m_tileSheet->tileCount(), TileChunkBuffer::maxTileID));
+        }
+
+        // Tiles loaded from a file may use IDs outside of the tile sheet, but they must still fit the widest tile ID
+        // type.
+        constexpr int maxTileID{TileStorage<std::uint16_t>::maxTileID};
+
+        if (const auto invalidTile{std::ranges::find_if(
+                tiles, [](const int tileID) { return tileID < 0 or tileID > maxTileID; })};
+            invalidTile != tiles.end()) {
+            throw std::runtime_error(std::format("Tile ID {0} is out of range, tile IDs must be between 0 and {1}.",
+                                                 *invalidTile, maxTileID));
+        }
+
+        const int layerTileCount{mapSize.x * mapSize.y};
+
+        for (int layer = 0; layer < layerCount; ++layer) {
+            const auto layerStart{tiles.begin() + layer * layerTileCount};
+            const std::vector<int> layerTiles(layerStart, layerStart + layerTileCount);
+            LayerStorage storage{createLayerStorage(layerTiles.empty() ? 0 : std::ranges::max(layerTiles))};
+
+            std::visit(
+                [&](auto& typedStorage) {
+                    typedStorage.setTiles({0, 0}, mapSize, layerTiles);
+                    // Generated maps tend to repeat whole chunks, e.g., large areas of grass or water.
+                    typedStorage.deduplicate();
+                },
+                storage);
+            m_layers.push_back({.tiles = std::move(storage)});
+        }
 
         Object::setSize(tileSize() * static_cast<glm::vec2>(mapSize));
+        updateTileOpacities();
+        markAllChunksDirty();
+        loadDirtyChunks();
+        publishSnapshot();
 
         addEventHandler([&](const Event event, const EventData& eventData) {
             if (event == Event::mouseClick) {
-                const glm::vec2 gridPos{(eventData.mousePosition.value() - bottomLeft(*this)) /
-                                        m_tileSheet->tileSize()};
+                const glm::ivec2 gridPos{
+                    glm::floor((eventData.mousePosition.value() - bottomLeft(*this)) / m_tileSheet->tileSize())};
 
                 for (const auto& callback : m_clickListeners) {
                     callback(gridPos, tileID(gridPos));
@@ -79,19 +291,58 @@ namespace TileEngine {
         return m_mapSize;
     }
 
-    void TileMap::setMapSize(const glm::ivec2 mapSize) {
+    void TileMap::setMapSize(const glm::ivec2 mapSize, const Anchor anchor) {
         assert(glm::all(glm::greaterThan(mapSize, glm::ivec2{0})) && "Map size must be positive.");
 
         if (glm::all(glm::equal(mapSize, m_mapSize))) {
             return;
         }
 
-        m_tiles = resizeTileMap(m_tiles, m_mapSize, mapSize);
+        const glm::i64vec2 oldMapSize{m_mapSize};
+        const glm::i64vec2 offset{resizeOffset(glm::i64vec2{mapSize} - oldMapSize, anchor)};
+
+        // Tiles that were inside the old map size but fall outside the new one are discarded. The kept region is in
+        // the coordinates from before the tiles are moved.
+        const glm::i64vec2 keptStart{glm::clamp(-offset, glm::i64vec2{0}, oldMapSize)};
+        const glm::i64vec2 keptEnd{glm::clamp(glm::i64vec2{mapSize} - offset, keptStart, oldMapSize)};
+        const std::array<TileRegion, 4> discardedStrips{{
+            {{0, 0}, {keptStart.x, oldMapSize.y}},
+            {{keptEnd.x, 0}, oldMapSize},
+            {{keptStart.x, 0}, {keptEnd.x, keptStart.y}},
+            {{keptStart.x, keptEnd.y}, {keptEnd.x, oldMapSize.y}},
+        }};
+
+        for (int layer = 0; layer < layerCount(); ++layer) {
+            for (const TileRegion& strip : discardedStrips) {
+                const std::vector<glm::i64vec2> clearedChunks{changeRegion(layer, strip, [&](LayerStorage& storage) {
+                    return std::visit(
+                        [&](auto& layerTiles) {
+                            return layerTiles.clear(storageCoordinates(strip.start), storageCoordinates(strip.end));
+                        },
+                        storage);
+                })};
+
+                if (!clearedChunks.empty()) {
+                    m_dirtyChunks.insert(clearedChunks.begin(), clearedChunks.end());
+                    m_changes.markChanged(strip, layer);
+                    m_unpublishedLayers |= 1u << layer;
+                }
+            }
+        }
+
         m_mapSize = mapSize;
         setSize(tileSize() * static_cast<glm::vec2>(mapSize));
 
+        if (offset != glm::i64vec2{0}) {
+            translateTiles(offset);
+        }
+
+        if (m_tileIDTexture != nullptr) {
+            m_tileIDTexture = TileIDTexture::create(m_mapSize, layerCount(), tilesOfAllLayers());
+        }
+
         if (m_gridLines.has_value()) {
-            enableGridLines();
+            m_gridLines->setGridSize(mapSize);
         }
     }
 
@@ -99,26 +350,358 @@ namespace TileEngine {
         return m_tileSheet->tileSize();
     }
 
-    int TileMap::tileID(const glm::ivec2 gridCoordinates) const {
-        return m_tiles.at(gridCoordinates.y * mapSize().x + gridCoordinates.x);
+    int TileMap::tileID(const glm::i64vec2 gridCoordinates, const int layer) const {
+        assert(layer >= 0 and layer < layerCount() and "Layer index out of range.");
+
+        const glm::i64vec2 storedCoordinates{storageCoordinates(gridCoordinates)};
+        return std::visit([&](const auto& layerTiles) { return layerTiles.tileID(storedCoordinates); },
+                          m_layers[layer].tiles);
+    }
+
+    void TileMap::setTileID(const glm::i64vec2 gridCoordinates, const int tileID, const int layer) {
+        assert(layer >= 0 and layer < layerCount() and "Layer index out of range.");
+
+        widenLayerStorage(layer, tileID);
+        const glm::i64vec2 storedCoordinates{storageCoordinates(gridCoordinates)};
+        const glm::i64vec2 chunkCoordinates{ChunkGrid::toChunkCoordinates(storedCoordinates)};
+
+        if (tileIndexEnabled()) {
+            m_tileIndices[layer].removeTile(chunkCoordinates, this->tileID(gridCoordinates, layer));
+            m_tileIndices[layer].addTile(chunkCoordinates, tileID);
+        }
+
+        std::visit([&](auto& layerTiles) { layerTiles.setTileID(storedCoordinates, tileID); }, m_layers[layer].tiles);
+        m_dirtyChunks.insert(chunkCoordinates);
+        m_changes.markChanged({gridCoordinates, gridCoordinates + std::int64_t{1}}, layer);
+        m_unpublishedLayers |= 1u << layer;
+
+        const bool insideMap{glm::all(glm::greaterThanEqual(gridCoordinates, glm::i64vec2{0})) and
+                             glm::all(glm::lessThan(gridCoordinates, glm::i64vec2{m_mapSize}))};
+
+        if (m_tileIDTexture != nullptr and insideMap) {
+            m_tileIDTexture->setTileID(glm::ivec2{gridCoordinates}, layer, tileID);
+        }
+    }
+
+    void TileMap::fillRegion(const TileRegion& region, const int tileID, const int layer) {
+        assert(layer >= 0 and layer < layerCount() and "Layer index out of range.");
+
+        widenLayerStorage(layer, tileID);
+        const std::vector changedChunks{changeRegion(layer, region, [&](LayerStorage& storage) {
+            return std::visit(
+                [&](auto& layerTiles) {
+                    return layerTiles.fill(storageCoordinates(region.start), storageCoordinates(region.end), tileID);
+                },
+                storage);
+        })};
+        onRegionChanged(region, layer, changedChunks);
+    }
+
+    void TileMap::copyRegion(const TileMap& source, const TileRegion& sourceRegion, const glm::i64vec2 destination,
+                             const int sourceLayer, const int destinationLayer) {
+        assert(sourceLayer >= 0 and sourceLayer < source.layerCount() and "Source layer index out of range.");
+        assert(destinationLayer >= 0 and destinationLayer < layerCount() and "Destination layer index out of range.");
+
+        const glm::i64vec2 regionSize{sourceRegion.end - sourceRegion.start};
+
+        if (glm::any(glm::lessThanEqual(regionSize, glm::i64vec2{0}))) {
+            return;
+        }
+
+        assert(glm::all(glm::lessThanEqual(regionSize, glm::i64vec2{std::numeric_limits<int>::max()})) and
+               "Region too large to copy.");
+
+        // Reading the whole region before writing any of it keeps overlapping copies within one map correct.
+        const glm::ivec2 size{regionSize};
+        const std::vector<int> tiles{std::visit(
+            [&](const auto& layerTiles) {
+                return layerTiles.tiles(source.storageCoordinates(sourceRegion.start), size);
+            },
+            source.m_layers[sourceLayer].tiles)};
+
+        const TileRegion destinationRegion{destination, destination + regionSize};
+        widenLayerStorage(destinationLayer, std::ranges::max(tiles));
+        const std::vector changedChunks{changeRegion(destinationLayer, destinationRegion, [&](LayerStorage& storage) {
+            return std::visit(
+                [&](auto& layerTiles) { return layerTiles.setTiles(storageCoordinates(destination), size, tiles); },
+                storage);
+        })};
+        onRegionChanged(destinationRegion, destinationLayer, changedChunks);
+    }
+
+    void TileMap::replaceInRegion(const TileRegion& region, const int fromTileID, const int toTileID,
+                                  const int layer) {
+        assert(layer >= 0 and layer < layerCount() and "Layer index out of range.");
+
+        widenLayerStorage(layer, toTileID);
+
+        // The storage reports how many tiles it replaced in each chunk, so the index moves them from one tile ID to
+        // the other without reading any tiles.
+        std::vector<int> replacedCounts{};
+        const std::vector changedChunks{std::visit(
+            [&](auto& layerTiles) {
+                return layerTiles.replace(storageCoordinates(region.start), storageCoordinates(region.end), fromTileID,
+                                          toTileID, tileIndexEnabled() ? &replacedCounts : nullptr);
+            },
+            m_layers[layer].tiles)};
+
+        if (tileIndexEnabled()) {
+            for (std::size_t i = 0; i < changedChunks.size(); ++i) {
+                m_tileIndices[layer].removeTiles(changedChunks[i], fromTileID, replacedCounts[i]);
+                m_tileIndices[layer].addTiles(changedChunks[i], toTileID, replacedCounts[i]);
+            }
+        }
+
+        onRegionChanged(region, layer, changedChunks);
+    }
+
+    std::int64_t TileMap::countInRegion(const TileRegion& region, const int tileID, const int layer) const {
+        assert(layer >= 0 and layer < layerCount() and "Layer index out of range.");
+
+        return std::visit(
+            [&](const auto& layerTiles) {
+                return layerTiles.count(storageCoordinates(region.start), storageCoordinates(region.end), tileID);
+            },
+            m_layers[layer].tiles);
+    }
+
+    void TileMap::translateTiles(const glm::i64vec2 offset) {
+        // Listeners see every stored chunk move, both where its tiles were and where they are now.
+        for (int layer = 0; layer < layerCount(); ++layer) {
+            for (const glm::i64vec2 chunkCoordinates : storedChunks(layer)) {
+                const glm::i64vec2 chunkStart{chunkCoordinates * static_cast<std::int64_t>(chunkSize) + m_gridOrigin};
+                const glm::i64vec2 chunkEnd{chunkStart + static_cast<std::int64_t>(chunkSize)};
+                m_changes.markChanged({chunkStart, chunkEnd}, layer);
+                m_changes.markChanged({chunkStart + offset, chunkEnd + offset}, layer);
+            }
+        }
+
+        m_gridOrigin += offset;
+        m_unpublishedLayers |= (1u << layerCount()) - 1;
+
+        // The chunk buffers and baked tiles are positioned when they are drawn, so only the scroll buffer, which holds
+        // the tiles at their grid coordinates, is out of date.
+        m_scrollBufferBounds.reset();
+        m_staleScrollBufferChunks.clear();
+    }
+
+    glm::i64vec2 TileMap::storageCoordinates(const glm::i64vec2 gridCoordinates) const {
+        return gridCoordinates - m_gridOrigin;
+    }
+
+    void TileMap::enableTileIndex() {
+        if (tileIndexEnabled()) {
+            return;
+        }
+
+        m_tileIndices.resize(m_layers.size());
+
+        for (int layer = 0; layer < layerCount(); ++layer) {
+            for (const glm::i64vec2 chunkCoordinates : storedChunks(layer)) {
+                m_tileIndices[layer].addChunk(chunkCoordinates, chunkTileIDs(layer, chunkCoordinates));
+            }
+        }
+    }
+
+    bool TileMap::tileIndexEnabled() const {
+        return !m_tileIndices.empty();
+    }
+
+    std::vector<glm::i64vec2> TileMap::findTiles(const int tileID, const int layer) const {
+        assert(layer >= 0 and layer < layerCount() and "Layer index out of range.");
+        assert(tileID != 0 and "Cannot find empty tiles.");
+
+        const std::vector<glm::i64vec2> chunks{tileIndexEnabled() ? m_tileIndices[layer].chunksWith(tileID)
+                                                                  : storedChunks(layer)};
+        std::vector<glm::i64vec2> foundTiles{};
+
+        for (const glm::i64vec2 chunkCoordinates : chunks) {
+            const std::vector<int> tiles{chunkTileIDs(layer, chunkCoordinates)};
+            const glm::i64vec2 chunkStart{chunkCoordinates * static_cast<std::int64_t>(chunkSize) + m_gridOrigin};
+
+            for (int i = 0; i < static_cast<int>(tiles.size()); ++i) {
+                if (tiles[i] == tileID) {
+                    foundTiles.push_back(chunkStart + glm::i64vec2{i % chunkSize, i / chunkSize});
+                }
+            }
+        }
+
+        return foundTiles;
+    }
+
+    void TileMap::replaceAll(const int fromTileID, const int toTileID, const int layer) {
+        assert(layer >= 0 and layer < layerCount() and "Layer index out of range.");
+        assert(fromTileID != 0 and "Cannot replace every empty tile, use `replaceInRegion` instead.");
+
+        const std::vector<glm::i64vec2> chunks{tileIndexEnabled() ? m_tileIndices[layer].chunksWith(fromTileID)
+                                                                  : storedChunks(layer)};
+
+        for (const glm::i64vec2 chunkCoordinates : chunks) {
+            const glm::i64vec2 chunkStart{chunkCoordinates * static_cast<std::int64_t>(chunkSize) + m_gridOrigin};
+            replaceInRegion({chunkStart, chunkStart + static_cast<std::int64_t>(chunkSize)}, fromTileID, toTileID,
+                            layer);
+        }
+    }
+
+    std::vector<std::pair<int, std::int64_t>> TileMap::tileHistogram(const int layer) const {
+        assert(layer >= 0 and layer < layerCount() and "Layer index out of range.");
+
+        if (tileIndexEnabled()) {
+            return m_tileIndices[layer].histogram();
+        }
+
+        TileIndex index{};
+
+        for (const glm::i64vec2 chunkCoordinates : storedChunks(layer)) {
+            index.addChunk(chunkCoordinates, chunkTileIDs(layer, chunkCoordinates));
+        }
+
+        return index.histogram();
+    }
+
+    std::int64_t TileMap::canonicalizeTileIDs() {
+        std::int64_t replacedCount{0};
+
+        for (int layer = 0; layer < layerCount(); ++layer) {
+            for (const auto& [tileID, tileCount] : tileHistogram(layer)) {
+                const int canonicalTileID{m_tileSheet->canonicalTileID(tileID)};
+
+                if (canonicalTileID != tileID and !isAnimated(tileID) and !isAnimated(canonicalTileID)) {
+                    replaceAll(tileID, canonicalTileID, layer);
+                    replacedCount += tileCount;
+                }
+            }
+        }
+
+        return replacedCount;
+    }
+
+    std::size_t TileMap::deduplicateChunks() {
+        std::size_t sharedChunkCount{0};
+
+        for (auto& [tiles, visible, opacity] : m_layers) {
+            sharedChunkCount += std::visit([](auto& layerTiles) { return layerTiles.deduplicate(); }, tiles);
+        }
+
+        return sharedChunkCount;
+    }
+
+    std::vector<int> TileMap::tiles(const int layer) const {
+        const glm::i64vec2 start{storageCoordinates({0, 0})};
+        return std::visit([&](const auto& layerTiles) { return layerTiles.tiles(start, m_mapSize); },
+                          m_layers.at(layer).tiles);
     }
 
-    void TileMap::setTileID(const glm::ivec2 gridCoordinates, const int tileID) {
-        m_tiles.at(gridCoordinates.y * mapSize().x + gridCoordinates.x) = tileID;
+    int TileMap::layerCount() const {
+        return static_cast<int>(m_layers.size());
     }
 
-    std::vector<int> TileMap::tiles() const {
-        return m_tiles;
+    int TileMap::addLayer() {
+        assert(layerCount() < maxLayers and "Cannot add more than `maxLayers` layers to a tile map.");
+
+        m_layers.push_back({.tiles = createLayerStorage()});
+
+        if (tileIndexEnabled()) {
+            m_tileIndices.emplace_back();
+        }
+
+        if (m_tileIDTexture != nullptr) {
+            m_tileIDTexture = TileIDTexture::create(m_mapSize, layerCount(), tilesOfAllLayers());
+        }
+
+        return layerCount() - 1;
+    }
+
+    bool TileMap::layerVisible(const int layer) const {
+        return m_layers.at(layer).visible;
+    }
+
+    void TileMap::setLayerVisible(const int layer, const bool visible) {
+        if (m_layers.at(layer).visible == visible) {
+            return;
+        }
+
+        // Hidden layers are left out of the chunk buffers entirely rather than being drawn fully transparent.
+        m_layers.at(layer).visible = visible;
+        markAllChunksDirty();
+    }
+
+    float TileMap::layerOpacity(const int layer) const {
+        return m_layers.at(layer).opacity;
+    }
+
+    void TileMap::setLayerOpacity(const int layer, const float opacity) {
+        float& layerOpacity{m_layers.at(layer).opacity};
+        const bool wasOpaque{layerOpacity == 1.0f};
+        layerOpacity = std::clamp(opacity, 0.0f, 1.0f);
+
+        // Baked tiles and the scroll buffer include the layer opacity.
+        m_bakedChunks.clear();
+        m_bakedChunkGroups.clear();
+        m_scrollBufferBounds.reset();
+
+        // Tiles on partially transparent layers have to be blended, so they move between the opaque and translucent
+        // instances of their chunks.
+        if (wasOpaque != (layerOpacity == 1.0f)) {
+            markAllChunksDirty();
+        }
+    }
+
+    const std::vector<TileAnimation>& TileMap::animations() const {
+        return m_animations;
+    }
+
+    void TileMap::setAnimations(const std::vector<TileAnimation>& animations) {
+        m_animations = animations;
+        m_animationTable = animations.empty() ? nullptr : TileAnimationTable::create(animations);
+        updateTileOpacities();
+        markAllChunksDirty();
     }
 
     std::string TileMap::texturePath() const {
         return m_tileSheet->texturePath();
     }
 
+    const TileSheet& TileMap::tileSheet() const {
+        return *m_tileSheet;
+    }
+
     void TileMap::addClickListener(const std::function<void(glm::ivec2 gridCoordinate, int tileID)>& callback) {
         m_clickListeners.push_back(callback);
     }
 
+    TileMap::RenderMode TileMap::renderMode() const {
+        return m_renderMode;
+    }
+
+    void TileMap::setRenderMode(const RenderMode renderMode) {
+        if (renderMode == RenderMode::tileIDTexture and m_tileSheet->tileCount() > TileIDTexture::maxTileID) {
+            throw std::runtime_error(
+                std::format("The tile sheet has {0} tiles, but the tile ID texture render mode supports at most {1}.",
+                            m_tileSheet->tileCount(), TileIDTexture::maxTileID));
+        }
+
+        m_renderMode = renderMode;
+
+        if (renderMode != RenderMode::scrollBuffer) {
+            m_scrollBuffer = nullptr;
+            m_scrollBufferBounds.reset();
+            m_staleScrollBufferChunks.clear();
+        }
+
+        switch (renderMode) {
+        case RenderMode::instanced:
+        case RenderMode::scrollBuffer:
+            m_tileIDTexture = nullptr;
+            break;
+        case RenderMode::tileIDTexture:
+            if (m_tileIDTexture == nullptr) {
+                m_tileIDTexture = TileIDTexture::create(m_mapSize, layerCount(), tilesOfAllLayers());
+            }
+            break;
+        }
+    }
+
     void TileMap::enableGridLines() {
         m_gridLines.emplace(mapSize(), tileSize());
         m_gridLines->setPosition(position());
@@ -142,6 +725,61 @@ namespace TileEngine {
         }
     }
 
+    void TileMap::addChangeListener(const TileChangeTracker::ChangeListener& listener) {
+        m_changes.addListener(listener);
+    }
+
+    const TileChanges& TileMap::pendingChanges() const {
+        return m_changes.pendingChanges();
+    }
+
+    std::uint64_t TileMap::chunkGeneration(const glm::i64vec2 chunkCoordinates) const {
+        return m_changes.chunkGeneration(chunkCoordinates);
+    }
+
+    std::shared_ptr<const TileMap::Snapshot> TileMap::snapshot() const {
+        return m_snapshot.load(std::memory_order_acquire);
+    }
+
+    void TileMap::publishSnapshot() {
+        const std::shared_ptr previous{m_snapshot.load(std::memory_order_relaxed)};
+        std::vector<std::shared_ptr<const LayerStorage>> layers{};
+        layers.reserve(m_layers.size());
+
+        for (int layer = 0; layer < layerCount(); ++layer) {
+            const bool unchanged{previous != nullptr and layer < previous->layerCount() and
+                                 (m_unpublishedLayers & 1u << layer) == 0};
+
+            // Copying the storage only copies the chunk pointers, the chunks themselves are shared.
+            layers.push_back(unchanged ? previous->m_layers[layer]
+                                       : std::make_shared<const LayerStorage>(m_layers[layer].tiles));
+        }
+
+        const std::uint64_t generation{previous == nullptr ? 1 : previous->generation() + 1};
+        m_snapshot.store(std::make_shared<const Snapshot>(m_mapSize, m_gridOrigin, std::move(layers), generation),
+                         std::memory_order_release);
+        m_unpublishedLayers = 0;
+    }
+
+    std::size_t TileMap::chunkMemoryBudget() const {
+        return m_chunkMemoryBudget;
+    }
+
+    void TileMap::setChunkMemoryBudget(const std::size_t memoryBudget) {
+        m_chunkMemoryBudget = memoryBudget;
+        compressColdChunks();
+    }
+
+    ChunkCacheStats TileMap::chunkCacheStats() const {
+        ChunkCacheStats stats{};
+
+        for (const auto& [tiles, visible, opacity] : m_layers) {
+            stats += std::visit([](const auto& layerTiles) { return layerTiles.cacheStats(); }, tiles);
+        }
+
+        return stats;
+    }
+
     void TileMap::setAnchor(const Anchor anchor) {
         Object::setAnchor(anchor);
 
@@ -151,64 +789,485 @@ namespace TileEngine {
     }
 
     void TileMap::update(const float deltaTime, const InputState& inputState, const Camera& camera) {
+        m_animationTime += deltaTime;
+
+        // Chunks are left dirty while they are not being drawn and are reloaded once instancing is used again.
+        if (m_renderMode != RenderMode::tileIDTexture) {
+            loadDirtyChunks();
+            bakeVisibleChunks(camera);
+        }
+
+        if (m_renderMode == RenderMode::scrollBuffer) {
+            updateScrollBuffer(camera);
+        }
+
         if (m_gridLines.has_value()) {
             m_gridLines->update(deltaTime, inputState, camera);
         }
+
+        if (m_animationTime - m_lastChunkCompressionTime >= chunkCompressionInterval) {
+            compressColdChunks();
+            m_lastChunkCompressionTime = m_animationTime;
+        }
+
+        if (const std::shared_ptr published{snapshot()};
+            m_unpublishedLayers != 0 or layerCount() != published->layerCount() or
+            glm::any(glm::notEqual(m_mapSize, published->mapSize()))) {
+            publishSnapshot();
+        }
+
+        m_changes.flush();
     }
 
     void TileMap::render(const Graphics& graphics) const {
-        const auto [rowStart, rowEnd, colStart, colEnd]{calculateVisibleGridBounds(graphics.camera)};
+        graphics.spriteBatch->flush();
+
+        const GridBounds bounds{calculateVisibleGridBounds(graphics.camera)};
+
+        switch (m_renderMode) {
+        case RenderMode::instanced:
+            renderInstanced(graphics, bounds);
+            break;
+        case RenderMode::scrollBuffer:
+            // The scroll buffer is only kept while tiles are drawn one by one, zoomed out views use the baked tiles.
+            if (detailLevel(graphics.camera) == DetailLevel::tiles and m_scrollBufferBounds.has_value()) {
+                renderScrollBuffer(graphics, bounds);
+            } else {
+                renderInstanced(graphics, bounds);
+            }
+            break;
+        case RenderMode::tileIDTexture:
+            renderTileIDTexture(graphics, bounds);
+            break;
+        }
+
+        if (m_gridLines.has_value()) {
+            m_gridLines->render(graphics);
+        }
+    }
+
+    void TileMap::renderInstanced(const Graphics& graphics, const GridBounds& bounds) const {
+        switch (detailLevel(graphics.camera)) {
+        case DetailLevel::tiles:
+            renderChunks(findVisibleChunks(bounds), projectionViewMatrix(graphics.camera), gridTransform());
+            break;
+        case DetailLevel::chunks:
+            renderBakedTiles(graphics, bounds, m_bakedChunks, 1);
+            break;
+        case DetailLevel::chunkGroups:
+            renderBakedTiles(graphics, bounds, m_bakedChunkGroups, ChunkGrid::chunkGroupSize);
+            break;
+        }
+    }
+
+    void TileMap::bindAnimations(const Shader& shader) const {
+        // The animation samplers are always given their own texture units, even when unused, since samplers of
+        // different types may not share a texture unit.
+        shader.setUniform("animationTable", animationTableTextureUnit - GL_TEXTURE0);
+        shader.setUniform("animationFrames", animationFramesTextureUnit - GL_TEXTURE0);
+        shader.setUniform("animated", m_animationTable != nullptr);
+
+        if (m_animationTable == nullptr) {
+            return;
+        }
+
+        // The time wraps around rather than overflowing the integer uniform, which causes a single skipped frame
+        // roughly every 24 days.
+        constexpr double timeRange{static_cast<double>(std::numeric_limits<int>::max()) + 1.0};
+        shader.setUniform("time", static_cast<int>(std::fmod(m_animationTime * 1000.0, timeRange)));
+        m_animationTable->bind(animationTableTextureUnit, animationFramesTextureUnit);
+    }
+
+    glm::mat4 TileMap::gridTransform() const {
+        return glm::scale(glm::translate(glm::mat4{1.0f}, glm::vec3{bottomLeft(*this), layer()}),
+                          glm::vec3{tileSize(), 1.0f});
+    }
+
+    std::vector<TileMap::VisibleChunk> TileMap::findVisibleChunks(const GridBounds& bounds) const {
+        const auto [rowStart, rowEnd, colStart, colEnd]{bounds};
+        std::vector<VisibleChunk> visibleChunks{};
+
+        if (rowStart >= rowEnd or colStart >= colEnd) {
+            return visibleChunks;
+        }
+
+        // All layers of a chunk are drawn together, so each visible chunk is drawn in full and the GPU clips any tiles
+        // outside the viewport.
+        const glm::i64vec2 firstChunk{ChunkGrid::toChunkCoordinates(storageCoordinates({colStart, rowStart}))};
+        const glm::i64vec2 lastChunk{ChunkGrid::toChunkCoordinates(storageCoordinates({colEnd - 1, rowEnd - 1}))};
+        const glm::i64vec2 visibleChunkGridSize{lastChunk - firstChunk + std::int64_t{1}};
+
+        // When zoomed far out there can be many more visible chunk coordinates than chunks with tiles, in which case it
+        // is cheaper to go through the chunk buffers than to look up every visible chunk.
+        if (static_cast<std::uint64_t>(visibleChunkGridSize.x * visibleChunkGridSize.y) > m_chunkBuffers.size()) {
+            for (const auto& [chunkCoordinates, chunk] : m_chunkBuffers) {
+                if (glm::all(glm::greaterThanEqual(chunkCoordinates, firstChunk)) and
+                    glm::all(glm::lessThanEqual(chunkCoordinates, lastChunk))) {
+                    visibleChunks.push_back({chunkCoordinates, chunk.get()});
+                }
+            }
+
+            return visibleChunks;
+        }
+
+        for (std::int64_t chunkRow = firstChunk.y; chunkRow <= lastChunk.y; ++chunkRow) {
+            for (std::int64_t chunkCol = firstChunk.x; chunkCol <= lastChunk.x; ++chunkCol) {
+                if (const auto chunk{m_chunkBuffers.find({chunkCol, chunkRow})}; chunk != m_chunkBuffers.end()) {
+                    visibleChunks.push_back({chunk->first, chunk->second.get()});
+                }
+            }
+        }
+
+        return visibleChunks;
+    }
+
+    void TileMap::renderChunks(const std::vector<VisibleChunk>& chunks, const glm::mat4& projectionViewMatrix,
+                               const glm::mat4& transform) const {
+        // Chunk origins are sent relative to the first chunk, so that they fit the shader's 32-bit integers however
+        // far the chunks are from the grid origin. The rest of the offset goes into the transform.
+        const glm::i64vec2 referenceChunk{chunks.empty() ? glm::i64vec2{0} : chunks.front().first};
+        const glm::i64vec2 referenceOrigin{referenceChunk * static_cast<std::int64_t>(chunkSize) + m_gridOrigin};
 
         m_shader.bind();
-        m_shader.setUniform("projectionViewMatrix", projectionViewMatrix(graphics.camera));
-        m_shader.setUniform("tileSize", m_tileSheet->textureCoordinateStride());
+        m_shader.setUniform("projectionViewMatrix", projectionViewMatrix);
+        m_shader.setUniform("transform", glm::translate(transform, glm::vec3{glm::vec2{referenceOrigin}, 0.0f}));
+        m_shader.setUniform("tileSize", m_tileSheet->textureCoordinateSize());
+        m_shader.setUniform("tileStride", m_tileSheet->textureCoordinateStride());
+        m_shader.setUniform("tileInset", m_tileSheet->textureCoordinateInset());
+        m_shader.setUniform("sheetSize", static_cast<glm::ivec2>(m_tileSheet->sheetSize()));
+        m_shader.setUniform("textureArray", m_tileSheet->usesTextureArray());
+        m_shader.setUniform("layerSpacing", layerDepthSpacing);
+        const std::vector layerOpacities{effectiveLayerOpacities()};
+        glUniform1fv(m_shader.uniformLocation("layerOpacity"), layerCount(), layerOpacities.data());
+        bindAnimations(m_shader);
         m_tileSheet->bind();
 
-        std::vector<glm::mat4> transforms(m_shader.maxInstances());
-        std::vector<glm::vec2> textureCoordinatesInstanced(m_shader.maxInstances());
-        int tileIndex{0};
-        const glm::mat4 tileTransform{glm::scale(glm::translate(glm::mat4{1.0f}, glm::vec3{bottomLeft(*this), layer()}),
-                                                 glm::vec3{tileSize(), 1.0f})};
+        // Opaque and cut-out tiles are drawn first without blending. Their instances are ordered top layer first, so
+        // the depth test rejects the hidden pixels of lower layers before they are shaded. The caller's blend state is
+        // restored once the translucent tiles are drawn.
+        const BlendStateGuard blendState{};
+        glDisable(GL_BLEND);
+        m_shader.setUniform("alphaTest", true);
+
+        for (const auto& [chunkCoordinates, chunk] : chunks) {
+            m_shader.setUniform("chunkOrigin",
+                                glm::ivec2{(chunkCoordinates - referenceChunk) * static_cast<std::int64_t>(chunkSize)});
+            chunk->renderOpaque();
+        }
+
+        // Translucent tiles are then blended over them bottom layer first.
+        glEnable(GL_BLEND);
+        m_shader.setUniform("alphaTest", false);
+
+        for (const auto& [chunkCoordinates, chunk] : chunks) {
+            m_shader.setUniform("chunkOrigin",
+                                glm::ivec2{(chunkCoordinates - referenceChunk) * static_cast<std::int64_t>(chunkSize)});
+            chunk->renderTranslucent();
+        }
+    }
+
+    TileMap::DetailLevel TileMap::detailLevel(const Camera& camera) {
+        if (camera.zoom() >= chunkDetailZoom) {
+            return DetailLevel::tiles;
+        }
+
+        if (camera.zoom() >= chunkGroupDetailZoom) {
+            return DetailLevel::chunks;
+        }
+
+        return DetailLevel::chunkGroups;
+    }
+
+    void TileMap::bakeVisibleChunks(const Camera& camera) {
+        const DetailLevel level{detailLevel(camera)};
+
+        if (level == DetailLevel::tiles) {
+            return;
+        }
+
+        const std::vector visibleChunks{findVisibleChunks(calculateVisibleGridBounds(camera))};
+        // Chunk groups are baked straight from the tiles rather than from the baked chunks, so zooming straight out to
+        // the chunk group level does not have to bake every chunk first.
+        const int chunksAcross{level == DetailLevel::chunks ? 1 : ChunkGrid::chunkGroupSize};
+        auto& bakedTiles{level == DetailLevel::chunks ? m_bakedChunks : m_bakedChunkGroups};
+        std::unordered_set<glm::i64vec2, ChunkCoordinatesHash> visibleBakes{};
 
-        auto renderFn = [&] {
-            if (tileIndex == 0) {
-                return;
+        for (const glm::i64vec2 chunkCoordinates : visibleChunks | std::views::keys) {
+            visibleBakes.insert(level == DetailLevel::chunks ? chunkCoordinates
+                                                             : ChunkGrid::toChunkGroupCoordinates(chunkCoordinates));
+        }
+
+        std::vector<glm::i64vec2> missingBakes{};
+
+        for (const glm::i64vec2 bakeCoordinates : visibleBakes) {
+            if (!bakedTiles.contains(bakeCoordinates)) {
+                missingBakes.push_back(bakeCoordinates);
             }
+        }
 
-            glUniformMatrix4fv(m_shader.uniformLocation("transforms"), tileIndex, GL_FALSE, &transforms[0][0][0]);
-            glUniform2fv(m_shader.uniformLocation("textureCoordinates"), tileIndex, &textureCoordinatesInstanced[0][0]);
-            m_quad.render(tileIndex, GL_TRIANGLE_STRIP);
-        };
+        const std::size_t bakeCount{std::min(missingBakes.size(), maxBakesPerUpdate)};
+
+        // Keep the memory used by baked tiles bounded by dropping the ones that are out of view to make room.
+        if (bakedTiles.size() + bakeCount > maxBakedTextures) {
+            std::erase_if(bakedTiles, [&](const auto& bake) { return !visibleBakes.contains(bake.first); });
+        }
+
+        // Whatever is left unbaked is drawn tile by tile (see `renderBakedTiles`) until a later update bakes it.
+        for (std::size_t i = 0; i < bakeCount and bakedTiles.size() < maxBakedTextures; ++i) {
+            const glm::i64vec2 firstChunk{missingBakes[i] * std::int64_t{chunksAcross}};
+            bakedTiles.emplace(missingBakes[i], bakeTiles(firstChunk, chunksAcross));
+        }
+    }
 
-        for (int row = rowStart; row < rowEnd; ++row) {
-            for (int col = colStart; col < colEnd; ++col) {
-                const glm::ivec2 gridCoordinates{col, row};
-                const int tileID = this->tileID(gridCoordinates);
+    std::unique_ptr<RenderTexture> TileMap::bakeTiles(const glm::i64vec2 firstChunk, const int chunksAcross) const {
+        std::vector<VisibleChunk> chunks{};
 
-                if (tileID == 0) {
-                    continue;
+        for (std::int64_t chunkRow = firstChunk.y; chunkRow < firstChunk.y + chunksAcross; ++chunkRow) {
+            for (std::int64_t chunkCol = firstChunk.x; chunkCol < firstChunk.x + chunksAcross; ++chunkCol) {
+                if (const auto chunk{m_chunkBuffers.find({chunkCol, chunkRow})}; chunk != m_chunkBuffers.end()) {
+                    chunks.push_back({chunk->first, chunk->second.get()});
                 }
+            }
+        }
 
-                transforms[tileIndex] =
-                    glm::translate(tileTransform, glm::vec3{static_cast<float>(col), static_cast<float>(row), 0.0f});
-                textureCoordinatesInstanced[tileIndex] = m_tileSheet->textureCoordinates(tileID);
+        // Chunk groups cover more tiles with the same number of pixels since they are only drawn further zoomed out.
+        const float tilePixels{std::max(tileSize().x, tileSize().y)};
+        const int resolution{static_cast<int>(std::ceil(chunkSize * tilePixels * chunkDetailZoom))};
+        auto bakedTiles{RenderTexture::create({resolution, resolution})};
+
+        // Draw the region in grid coordinates, with the region's bottom left tile at the origin. The layers are given
+        // depths that fit in the clip volume.
+        const auto tilesAcross{static_cast<float>(chunksAcross * chunkSize)};
+        const glm::mat4 projection{glm::ortho(0.0f, tilesAcross, 0.0f, tilesAcross, -1.0f, 1.0f)};
+        const glm::i64vec2 regionStart{firstChunk * static_cast<std::int64_t>(chunkSize) + m_gridOrigin};
+        const glm::mat4 transform{glm::translate(glm::mat4{1.0f}, -glm::vec3{glm::vec2{regionStart}, 0.0f})};
+
+        drawOffscreen([&] { bakedTiles->renderTo([&] { renderChunks(chunks, projection, transform); }); });
+
+        return bakedTiles;
+    }
 
-                ++tileIndex;
+    void TileMap::updateScrollBuffer(const Camera& camera) {
+        if (detailLevel(camera) != DetailLevel::tiles) {
+            m_scrollBufferBounds.reset();
+            m_staleScrollBufferChunks.clear();
+            return;
+        }
+
+        const GridBounds visible{calculateVisibleGridBounds(camera)};
+        const glm::ivec2 visibleSize{visible.colEnd - visible.colStart, visible.rowEnd - visible.rowStart};
+
+        // The buffer only grows, e.g., when the window is resized or the camera zooms out.
+        if (m_scrollBuffer == nullptr or glm::any(glm::greaterThan(visibleSize, m_scrollBufferTiles))) {
+            m_scrollBufferTiles = visibleSize + scrollBufferMargin;
+            m_scrollBuffer = RenderTexture::create(m_scrollBufferTiles * glm::ivec2{tileSize()}, false, true);
+            m_scrollBufferBounds.reset();
+        }
+
+        if (!m_scrollBufferBounds.has_value()) {
+            drawToScrollBuffer(visible);
+            m_scrollBufferBounds = visible;
+            m_staleScrollBufferChunks.clear();
+            return;
+        }
+
+        const auto [rowStart, rowEnd, colStart, colEnd]{*m_scrollBufferBounds};
+
+        // Redraw the parts of the buffer whose tiles have changed.
+        for (const glm::i64vec2 chunkCoordinates : m_staleScrollBufferChunks) {
+            const glm::i64vec2 chunkStart{chunkCoordinates * static_cast<std::int64_t>(chunkSize) + m_gridOrigin};
+            drawToScrollBuffer({std::max(rowStart, chunkStart.y), std::min(rowEnd, chunkStart.y + chunkSize),
+                                std::max(colStart, chunkStart.x), std::min(colEnd, chunkStart.x + chunkSize)});
+        }
+
+        m_staleScrollBufferChunks.clear();
+
+        // Draw only the rows and columns that have scrolled into view. Since the visible area fits in the buffer, the
+        // tiles that are still in view keep their place in the wrapped-around buffer.
+        const std::int64_t overlapColStart{std::max(visible.colStart, colStart)};
+        const std::int64_t overlapColEnd{std::min(visible.colEnd, colEnd)};
+        const std::int64_t overlapRowStart{std::max(visible.rowStart, rowStart)};
+        const std::int64_t overlapRowEnd{std::min(visible.rowEnd, rowEnd)};
+
+        if (overlapColStart >= overlapColEnd or overlapRowStart >= overlapRowEnd) {
+            drawToScrollBuffer(visible);
+        } else {
+            // Columns to the left and right of the old area, then rows below and above it.
+            drawToScrollBuffer({visible.rowStart, visible.rowEnd, visible.colStart, overlapColStart});
+            drawToScrollBuffer({visible.rowStart, visible.rowEnd, overlapColEnd, visible.colEnd});
+            drawToScrollBuffer({visible.rowStart, overlapRowStart, overlapColStart, overlapColEnd});
+            drawToScrollBuffer({overlapRowEnd, visible.rowEnd, overlapColStart, overlapColEnd});
+        }
 
-                if (tileIndex == m_shader.maxInstances()) {
-                    renderFn();
-                    tileIndex = 0;
+        m_scrollBufferBounds = visible;
+    }
+
+    void TileMap::drawToScrollBuffer(const GridBounds& region) const {
+        const auto [rowStart, rowEnd, colStart, colEnd]{region};
+
+        if (rowStart >= rowEnd or colStart >= colEnd) {
+            return;
+        }
+
+        const std::vector chunks{findVisibleChunks(region)};
+        const glm::ivec2 tilePixels{tileSize()};
+        const glm::mat4 projection{glm::ortho(0.0f, static_cast<float>(m_scrollBufferTiles.x), 0.0f,
+                                              static_cast<float>(m_scrollBufferTiles.y), -1.0f, 1.0f)};
+
+        // Split a span of grid coordinates where it wraps around the edge of the buffer.
+        // Each piece is the offset into the span, the start in the buffer and the length in tiles.
+        const auto splitSpan{[](const std::int64_t start, const std::int64_t end, const int bufferLength) {
+            const int bufferStart{wrap(start, bufferLength)};
+            const int length{static_cast<int>(end - start)};
+            const int firstLength{std::min(length, bufferLength - bufferStart)};
+            std::vector<glm::ivec3> pieces{{0, bufferStart, firstLength}};
+
+            if (firstLength < length) {
+                pieces.emplace_back(firstLength, 0, length - firstLength);
+            }
+
+            return pieces;
+        }};
+
+        drawOffscreen([&] {
+            for (const glm::ivec3 colPiece : splitSpan(colStart, colEnd, m_scrollBufferTiles.x)) {
+                for (const glm::ivec3 rowPiece : splitSpan(rowStart, rowEnd, m_scrollBufferTiles.y)) {
+                    const glm::i64vec2 gridStart{colStart + colPiece.x, rowStart + rowPiece.x};
+                    const glm::ivec2 bufferStart{colPiece.y, rowPiece.y};
+                    const glm::ivec2 pieceSize{colPiece.z, rowPiece.z};
+                    // Move the grid coordinates of the piece to where the piece wraps around to in the buffer.
+                    const glm::mat4 transform{glm::translate(
+                        glm::mat4{1.0f}, glm::vec3{glm::vec2{bufferStart} - glm::vec2{gridStart}, 0.0f})};
+
+                    m_scrollBuffer->renderToRegion(bufferStart * tilePixels, pieceSize * tilePixels,
+                                                   [&] { renderChunks(chunks, projection, transform); });
                 }
             }
+        });
+    }
+
+    void TileMap::renderScrollBuffer(const Graphics& graphics, const GridBounds& bounds) const {
+        // The camera may have moved since the last update, in which case only the part of the view in the buffer is
+        // drawn.
+        const std::int64_t rowStart{std::max(bounds.rowStart, m_scrollBufferBounds->rowStart)};
+        const std::int64_t rowEnd{std::min(bounds.rowEnd, m_scrollBufferBounds->rowEnd)};
+        const std::int64_t colStart{std::max(bounds.colStart, m_scrollBufferBounds->colStart)};
+        const std::int64_t colEnd{std::min(bounds.colEnd, m_scrollBufferBounds->colEnd)};
+
+        if (rowStart >= rowEnd or colStart >= colEnd) {
+            return;
         }
 
-        renderFn();
+        constexpr int scrollBufferTextureUnit{GL_TEXTURE0};
 
-        if (m_gridLines.has_value()) {
-            m_gridLines->render(graphics);
+        m_scrollBufferShader.bind();
+        m_scrollBufferShader.setUniform("projectionViewMatrix", projectionViewMatrix(graphics.camera));
+        m_scrollBufferShader.setUniform("transform", gridTransform());
+        m_scrollBufferShader.setUniform("gridOffset", glm::vec2{colStart, rowStart});
+        m_scrollBufferShader.setUniform("gridExtent", glm::vec2{colEnd - colStart, rowEnd - rowStart});
+        m_scrollBufferShader.setUniform("bufferSize", m_scrollBufferTiles);
+        m_scrollBufferShader.setUniform("scrollBuffer", scrollBufferTextureUnit - GL_TEXTURE0);
+        m_scrollBuffer->bind(scrollBufferTextureUnit);
+
+        graphics.quad.render();
+    }
+
+    void TileMap::invalidateBakedTiles(const glm::i64vec2 chunkCoordinates) {
+        m_bakedChunks.erase(chunkCoordinates);
+        m_bakedChunkGroups.erase(ChunkGrid::toChunkGroupCoordinates(chunkCoordinates));
+
+        if (m_scrollBufferBounds.has_value()) {
+            m_staleScrollBufferChunks.push_back(chunkCoordinates);
         }
     }
 
+    void TileMap::renderBakedTiles(const Graphics& graphics, const GridBounds& bounds, const BakedTiles& bakedTiles,
+                                   const int chunksAcross) const {
+        const auto [rowStart, rowEnd, colStart, colEnd]{bounds};
+
+        if (rowStart >= rowEnd or colStart >= colEnd) {
+            return;
+        }
+
+        const std::int64_t tilesAcross{std::int64_t{chunksAcross} * chunkSize};
+        const glm::i64vec2 first{ChunkGrid::toChunkCoordinates(storageCoordinates({colStart, rowStart}))};
+        const glm::i64vec2 last{ChunkGrid::toChunkCoordinates(storageCoordinates({colEnd - 1, rowEnd - 1}))};
+        const glm::i64vec2 firstVisible{chunksAcross == 1 ? first : ChunkGrid::toChunkGroupCoordinates(first)};
+        const glm::i64vec2 lastVisible{chunksAcross == 1 ? last : ChunkGrid::toChunkGroupCoordinates(last)};
+        const glm::mat4 transform{gridTransform()};
+        constexpr int bakedTilesTextureUnit{GL_TEXTURE0};
+
+        m_bakedTilesShader.bind();
+        m_bakedTilesShader.setUniform("projectionViewMatrix", projectionViewMatrix(graphics.camera));
+        m_bakedTilesShader.setUniform("bakedTiles", bakedTilesTextureUnit - GL_TEXTURE0);
+
+        // There are at most `maxBakedTextures` baked textures, so going through all of them is cheap.
+        for (const auto& [coordinates, texture] : bakedTiles) {
+            if (glm::any(glm::lessThan(coordinates, firstVisible)) or
+                glm::any(glm::greaterThan(coordinates, lastVisible))) {
+                continue;
+            }
+
+            const glm::vec2 gridOrigin{coordinates * tilesAcross + m_gridOrigin};
+            m_bakedTilesShader.setUniform(
+                "transform", glm::scale(glm::translate(transform, glm::vec3{gridOrigin, 0.0f}),
+                                        glm::vec3{static_cast<float>(tilesAcross), static_cast<float>(tilesAcross),
+                                                  1.0f}));
+            texture->bind(bakedTilesTextureUnit);
+            graphics.quad.render();
+        }
+
+        // Visible chunks whose bake is still to come, or did not fit in the baked textures, are drawn tile by tile.
+        std::vector<VisibleChunk> unbakedChunks{};
+
+        for (const VisibleChunk& chunk : findVisibleChunks(bounds)) {
+            const glm::i64vec2 bakeCoordinates{chunksAcross == 1 ? chunk.first
+                                                                 : ChunkGrid::toChunkGroupCoordinates(chunk.first)};
+
+            if (!bakedTiles.contains(bakeCoordinates)) {
+                unbakedChunks.push_back(chunk);
+            }
+        }
+
+        if (!unbakedChunks.empty()) {
+            renderChunks(unbakedChunks, projectionViewMatrix(graphics.camera), transform);
+        }
+    }
+
+    void TileMap::renderTileIDTexture(const Graphics& graphics, const GridBounds& bounds) const {
+        // The tile ID texture only covers the tiles within the map size.
+        const std::int64_t rowStart{std::max(bounds.rowStart, std::int64_t{0})};
+        const std::int64_t rowEnd{std::min(bounds.rowEnd, std::int64_t{m_mapSize.y})};
+        const std::int64_t colStart{std::max(bounds.colStart, std::int64_t{0})};
+        const std::int64_t colEnd{std::min(bounds.colEnd, std::int64_t{m_mapSize.x})};
+
+        if (rowStart >= rowEnd or colStart >= colEnd) {
+            return;
+        }
+
+        const glm::mat4 transform{gridTransform()};
+        constexpr int tileIDTextureUnit{GL_TEXTURE1};
+
+        m_tileIDShader.bind();
+        m_tileIDShader.setUniform("projectionViewMatrix", projectionViewMatrix(graphics.camera));
+        m_tileIDShader.setUniform("transform", transform);
+        m_tileIDShader.setUniform("gridOffset", glm::vec2{colStart, rowStart});
+        m_tileIDShader.setUniform("gridExtent", glm::vec2{colEnd - colStart, rowEnd - rowStart});
+        m_tileIDShader.setUniform("tileSize", m_tileSheet->textureCoordinateSize());
+        m_tileIDShader.setUniform("tileStride", m_tileSheet->textureCoordinateStride());
+        m_tileIDShader.setUniform("tileInset", m_tileSheet->textureCoordinateInset());
+        m_tileIDShader.setUniform("sheetSize", static_cast<glm::ivec2>(m_tileSheet->sheetSize()));
+        m_tileIDShader.setUniform("tileIDs", tileIDTextureUnit - GL_TEXTURE0);
+        m_tileIDShader.setUniform("layerCount", layerCount());
+        const std::vector layerOpacities{effectiveLayerOpacities()};
+        glUniform1fv(m_tileIDShader.uniformLocation("layerOpacity"), layerCount(), layerOpacities.data());
+        bindAnimations(m_tileIDShader);
+        m_tileSheet->bind();
+        m_tileIDTexture->bind(tileIDTextureUnit);
+
+        graphics.quad.render();
+    }
+
     TileMap::GridBounds TileMap::calculateVisibleGridBounds(const Camera& camera) const {
         const auto [viewBottomLeft, viewTopRight]{camera.viewport()};
         const glm::vec2 bottomLeft{TileEngine::bottomLeft(*this)};
@@ -220,13 +1279,351 @@ namespace TileEngine {
         // appearing' only once they are fully in view.
         constexpr int padding{1};
 
-        const int rowStart = std::max(0, static_cast<int>(gridCoordinatesMin.y));
-        const int rowEnd = std::min(static_cast<int>(gridCoordinatesMax.y) + padding, m_mapSize.y);
+        // Tiles are not limited to the map size, so the bounds are not clamped to it.
+        const auto rowStart = static_cast<std::int64_t>(std::floor(gridCoordinatesMin.y));
+        const auto rowEnd = static_cast<std::int64_t>(std::floor(gridCoordinatesMax.y)) + padding;
 
-        const int colStart = std::max(0, static_cast<int>(gridCoordinatesMin.x));
-        const int colEnd = std::min(static_cast<int>(gridCoordinatesMax.x) + padding, m_mapSize.x);
+        const auto colStart = static_cast<std::int64_t>(std::floor(gridCoordinatesMin.x));
+        const auto colEnd = static_cast<std::int64_t>(std::floor(gridCoordinatesMax.x)) + padding;
 
         return {rowStart, rowEnd, colStart, colEnd};
     }
 
+    void TileMap::widenLayerStorage(const int layer, const int tileID) {
+        LayerStorage& storage{m_layers[layer].tiles};
+        const auto* narrowStorage{std::get_if<TileStorage<std::uint8_t>>(&storage)};
+
+        // Tile IDs from outside of the tile sheet may not fit the tile ID type picked for it.
+        if (narrowStorage != nullptr and tileID > TileStorage<std::uint8_t>::maxTileID) {
+            storage = TileStorage<std::uint16_t>{*narrowStorage};
+        }
+    }
+
+    std::vector<glm::i64vec2> TileMap::changeRegion(
+        const int layer, const TileRegion& region,
+        const std::function<std::vector<glm::i64vec2>(LayerStorage&)>& change) {
+        if (!tileIndexEnabled()) {
+            return change(m_layers[layer].tiles);
+        }
+
+        // Count the tiles of the region in each chunk before and after the change, and move only the difference in
+        // the index. Tiles outside of the region cannot change, so they are never read.
+        const auto countTiles{[&] {
+            return std::visit(
+                [&](const auto& layerTiles) {
+                    return layerTiles.tileCounts(storageCoordinates(region.start), storageCoordinates(region.end));
+                },
+                m_layers[layer].tiles);
+        }};
+
+        const std::vector<ChunkTileCounts> countsBefore{countTiles()};
+        const std::vector<glm::i64vec2> changedChunks{change(m_layers[layer].tiles)};
+
+        if (changedChunks.empty()) {
+            return changedChunks;
+        }
+
+        const std::unordered_set<glm::i64vec2, ChunkCoordinatesHash> changed{changedChunks.begin(),
+                                                                              changedChunks.end()};
+
+        for (const auto& [chunkCoordinates, tileCounts] : countsBefore) {
+            if (changed.contains(chunkCoordinates)) {
+                for (const auto& [tileID, tileCount] : tileCounts) {
+                    m_tileIndices[layer].removeTiles(chunkCoordinates, tileID, tileCount);
+                }
+            }
+        }
+
+        for (const auto& [chunkCoordinates, tileCounts] : countTiles()) {
+            if (changed.contains(chunkCoordinates)) {
+                for (const auto& [tileID, tileCount] : tileCounts) {
+                    m_tileIndices[layer].addTiles(chunkCoordinates, tileID, tileCount);
+                }
+            }
+        }
+
+        return changedChunks;
+    }
+
+    std::vector<int> TileMap::chunkTileIDs(const int layer, const glm::i64vec2 chunkCoordinates) const {
+        const glm::i64vec2 chunkStart{chunkCoordinates * static_cast<std::int64_t>(chunkSize)};
+
+        return std::visit([&](const auto& layerTiles) { return layerTiles.tiles(chunkStart, {chunkSize, chunkSize}); },
+                          m_layers[layer].tiles);
+    }
+
+    std::vector<glm::i64vec2> TileMap::storedChunks(const int layer) const {
+        return std::visit([](const auto& layerTiles) { return layerTiles.chunkCoordinates(); }, m_layers[layer].tiles);
+    }
+
+    void TileMap::onRegionChanged(const TileRegion& region, const int layer,
+                                  const std::vector<glm::i64vec2>& changedChunks) {
+        if (changedChunks.empty()) {
+            return;
+        }
+
+        m_dirtyChunks.insert(changedChunks.begin(), changedChunks.end());
+        m_changes.markChanged(region, layer);
+        m_unpublishedLayers |= 1u << layer;
+
+        if (m_tileIDTexture == nullptr) {
+            return;
+        }
+
+        // Upload the part of the region inside the map in one go.
+        const glm::i64vec2 start{glm::max(region.start, glm::i64vec2{0})};
+        const glm::i64vec2 end{glm::min(region.end, glm::i64vec2{m_mapSize})};
+
+        if (glm::all(glm::lessThan(start, end))) {
+            const glm::ivec2 size{end - start};
+            const std::vector<int> tiles{std::visit(
+                [&](const auto& layerTiles) { return layerTiles.tiles(storageCoordinates(start), size); },
+                m_layers[layer].tiles)};
+            m_tileIDTexture->setTiles(glm::ivec2{start}, size, layer, tiles);
+        }
+    }
+
+    TileMap::LayerStorage TileMap::createLayerStorage(const int largestTileID) const {
+        if (std::max(m_tileSheet->tileCount(), largestTileID) <= TileStorage<std::uint8_t>::maxTileID) {
+            return TileStorage<std::uint8_t>{};
+        }
+
+        return TileStorage<std::uint16_t>{};
+    }
+
+    std::vector<int> TileMap::tilesOfAllLayers() const {
+        std::vector<int> allTiles{};
+        allTiles.reserve(static_cast<std::size_t>(layerCount()) * m_mapSize.x * m_mapSize.y);
+
+        for (int layer = 0; layer < layerCount(); ++layer) {
+            const std::vector layerTiles{tiles(layer)};
+            allTiles.insert(allTiles.end(), layerTiles.begin(), layerTiles.end());
+        }
+
+        return allTiles;
+    }
+
+    std::vector<float> TileMap::effectiveLayerOpacities() const {
+        std::vector<float> opacities{};
+        opacities.reserve(m_layers.size());
+
+        for (const auto& [tiles, visible, opacity] : m_layers) {
+            opacities.push_back(visible ? opacity : 0.0f);
+        }
+
+        return opacities;
+    }
+
+    void TileMap::updateTileOpacities() {
+        m_tileOpacities.assign(m_tileSheet->tileCount() + 1, TileSheet::TileOpacity::translucent);
+
+        for (int tileID = 1; tileID <= m_tileSheet->tileCount(); ++tileID) {
+            m_tileOpacities[tileID] = m_tileSheet->tileOpacity(tileID);
+        }
+
+        for (const auto& [tileID, frames, frameDuration] : m_animations) {
+            if (tileID >= static_cast<int>(m_tileOpacities.size())) {
+                continue;
+            }
+
+            // `TileOpacity` is ordered from least to most see-through, except that a tile that is empty in some frames
+            // and opaque in others has holes in it part of the time.
+            for (const int frame : frames) {
+                // The initializer list overload returns copies, so neither value refers to the temporary opacity.
+                const auto [leastSeeThrough, mostSeeThrough]{
+                    std::minmax({m_tileOpacities[tileID], m_tileSheet->tileOpacity(frame)})};
+                m_tileOpacities[tileID] = leastSeeThrough == TileSheet::TileOpacity::empty and
+                                                  mostSeeThrough == TileSheet::TileOpacity::opaque
+                                              ? TileSheet::TileOpacity::cutout
+                                              : mostSeeThrough;
+            }
+        }
+    }
+
+    bool TileMap::drawsOpaque(const int tileID, const int layer) const {
+        return m_layers[layer].opacity == 1.0f and tileID < static_cast<int>(m_tileOpacities.size()) and
+               m_tileOpacities[tileID] != TileSheet::TileOpacity::translucent;
+    }
+
+    bool TileMap::hidesTilesBelow(const int tileID, const int layer) const {
+        return m_layers[layer].opacity == 1.0f and tileID < static_cast<int>(m_tileOpacities.size()) and
+               m_tileOpacities[tileID] == TileSheet::TileOpacity::opaque;
+    }
+
+    bool TileMap::isInvisible(const int tileID) const {
+        return tileID < static_cast<int>(m_tileOpacities.size()) and
+               m_tileOpacities[tileID] == TileSheet::TileOpacity::empty;
+    }
+
+    bool TileMap::isAnimated(const int tileID) const {
+        return std::ranges::find(m_animations, tileID, &TileAnimation::tileID) != m_animations.end();
+    }
+
+    void TileMap::compressColdChunks() {
+        if (m_chunkMemoryBudget == std::numeric_limits<std::size_t>::max()) {
+            return;
+        }
+
+        const std::size_t layerBudget{m_chunkMemoryBudget / m_layers.size()};
+
+        for (int layer = 0; layer < layerCount(); ++layer) {
+            const std::size_t compressedCount{std::visit(
+                [&](auto& layerTiles) { return layerTiles.compressColdChunks(layerBudget); }, m_layers[layer].tiles)};
+
+            // The last snapshot still holds the uncompressed chunks, which are only freed once it is replaced.
+            if (compressedCount > 0) {
+                m_unpublishedLayers |= 1u << layer;
+            }
+        }
+    }
+
+    void TileMap::markAllChunksDirty() {
+        // Redrawing the whole scroll buffer at once is cheaper than redrawing it chunk by chunk.
+        m_scrollBufferBounds.reset();
+
+        for (const auto& [chunkCoordinates, _] : m_chunkBuffers) {
+            m_dirtyChunks.insert(chunkCoordinates);
+        }
+
+        for (const auto& [tiles, visible, opacity] : m_layers) {
+            const std::vector<glm::i64vec2> chunkCoordinates{
+                std::visit([](const auto& layerTiles) { return layerTiles.chunkCoordinates(); }, tiles)};
+            m_dirtyChunks.insert(chunkCoordinates.begin(), chunkCoordinates.end());
+        }
+    }
+
+    void TileMap::loadDirtyChunks() {
+        for (const glm::i64vec2 chunkCoordinates : m_dirtyChunks) {
+            loadChunk(chunkCoordinates);
+        }
+
+        m_dirtyChunks.clear();
+    }
+
+    void TileMap::loadChunk(const glm::i64vec2 chunkCoordinates) {
+        invalidateBakedTiles(chunkCoordinates);
+
+        using ChunkMask = std::array<ChunkGrid::RowMask, chunkSize>;
+
+        std::vector<std::uint32_t> opaqueInstances{};
+        std::vector<std::uint32_t> translucentInstances{};
+
+        for (auto& [tiles, visible, opacity] : m_layers) {
+            std::visit([&](auto& layerTiles) { layerTiles.touchChunk(chunkCoordinates); }, tiles);
+        }
+
+        // Calls `callback(col, row, tileID)` for the tiles of a layer that are not hidden.
+        const auto forEachUnhiddenTile{[&](const int layer, const ChunkMask& hidden, const auto& callback) {
+            std::visit(
+                [&](const auto& layerTiles) {
+                    const std::span tiles{layerTiles.chunkTiles(chunkCoordinates)};
+
+                    // Empty chunks are not stored, so they are skipped before any per-tile work.
+                    if (tiles.empty()) {
+                        return;
+                    }
+
+                    const std::span occupancy{layerTiles.chunkOccupancy(chunkCoordinates)};
+
+                    // Jump straight from one occupied tile to the next instead of testing every tile in the chunk.
+                    // Fully transparent tiles are skipped, so they add no instances.
+                    for (int row = 0; row < chunkSize; ++row) {
+                        for (ChunkGrid::RowMask rowMask{occupancy[row] & ~hidden[row]}; rowMask != 0;
+                             rowMask &= rowMask - 1) {
+                            const int col{std::countr_zero(rowMask)};
+                            const int tileID{tiles[row * chunkSize + col]};
+
+                            if (!isInvisible(tileID)) {
+                                callback(col, row, tileID);
+                            }
+                        }
+                    }
+                },
+                m_layers[layer].tiles);
+        }};
+
+        // The cells covered by a fully opaque tile on a higher layer. Together these form the topmost opaque layer of
+        // each cell, below which no tiles are drawn, so stacked layers are drawn about once per cell.
+        ChunkMask covered{};
+        std::array<ChunkMask, maxLayers> coveredAbove{};
+
+        // Opaque instances are ordered top layer first, so that the depth test can reject the hidden parts of lower
+        // layers, and translucent instances bottom layer first, so that upper layers are blended on top.
+        for (int layer = layerCount() - 1; layer >= 0; --layer) {
+            coveredAbove[layer] = covered;
+
+            if (!m_layers[layer].visible) {
+                continue;
+            }
+
+            forEachUnhiddenTile(layer, coveredAbove[layer], [&](const int col, const int row, const int tileID) {
+                if (!drawsOpaque(tileID, layer)) {
+                    return;
+                }
+
+                opaqueInstances.push_back(TileChunkBuffer::packInstance({col, row}, layer, tileID));
+
+                if (hidesTilesBelow(tileID, layer)) {
+                    covered[row] |= ChunkGrid::RowMask{1} << col;
+                }
+            });
+        }
+
+        for (int layer = 0; layer < layerCount(); ++layer) {
+            if (!m_layers[layer].visible) {
+                continue;
+            }
+
+            forEachUnhiddenTile(layer, coveredAbove[layer], [&](const int col, const int row, const int tileID) {
+                if (!drawsOpaque(tileID, layer)) {
+                    translucentInstances.push_back(TileChunkBuffer::packInstance({col, row}, layer, tileID));
+                }
+            });
+        }
+
+        if (opaqueInstances.empty() and translucentInstances.empty()) {
+            m_chunkBuffers.erase(chunkCoordinates);
+            return;
+        }
+
+        auto& chunkBuffer{m_chunkBuffers[chunkCoordinates]};
+
+        if (chunkBuffer == nullptr) {
+            chunkBuffer = std::make_unique<TileChunkBuffer>();
+        }
+
+        chunkBuffer->loadInstanceData(opaqueInstances, translucentInstances);
+    }
+
+    TileMap::Snapshot::Snapshot(const glm::ivec2 mapSize, const glm::i64vec2 gridOrigin,
+                                std::vector<std::shared_ptr<const LayerStorage>> layers,
+                                const std::uint64_t generation) :
+        m_mapSize(mapSize), m_gridOrigin(gridOrigin), m_layers(std::move(layers)), m_generation(generation) {
+    }
+
+    glm::ivec2 TileMap::Snapshot::mapSize() const {
+        return m_mapSize;
+    }
+
+    int TileMap::Snapshot::layerCount() const {
+        return static_cast<int>(m_layers.size());
+    }
+
+    int TileMap::Snapshot::tileID(const glm::i64vec2 gridCoordinates, const int layer) const {
+        assert(layer >= 0 and layer < layerCount() and "Layer index out of range.");
+
+        return std::visit([&](const auto& layerTiles) { return layerTiles.tileID(gridCoordinates - m_gridOrigin); },
+                          *m_layers[layer]);
+    }
+
+    std::vector<int> TileMap::Snapshot::tiles(const int layer) const {
+        assert(layer >= 0 and layer < layerCount() and "Layer index out of range.");
+
+        return std::visit([&](const auto& layerTiles) { return layerTiles.tiles(-m_gridOrigin, m_mapSize); },
+                          *m_layers[layer]);
+    }
+
+    std::uint64_t TileMap::Snapshot::generation() const {
+        return m_generation;
+    }
 } // namespace TileEngine
@@ -6,32 +6,86 @@
 #include <TileEngine/Camera.hpp>
 #include <TileEngine/GridLines.hpp>
 #include <TileEngine/Object.hpp>
-#include <TileEngine/Quad.hpp>
+#include <TileEngine/RenderTexture.hpp>
 #include <TileEngine/Shader.hpp>
+#include <TileEngine/TileAnimationTable.hpp>
+#include <TileEngine/TileChangeTracker.hpp>
+#include <TileEngine/TileChunkBuffer.hpp>
+#include <TileEngine/TileIDTexture.hpp>
+#include <TileEngine/TileIndex.hpp>
 #include <TileEngine/TileSheet.hpp>
+#include <TileEngine/TileStorage.hpp>
+#include <atomic>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
 
 namespace TileEngine {
     /// Handles loading and accessing a textured-based tile map.
+    /// @note Tiles are stored sparsely in chunks, so tiles may be set anywhere, including outside of the map size and
+    /// at negative grid coordinates. The map size determines the area that is saved, covered by grid lines and drawn by
+    /// the tile ID texture render mode.
+    /// @note When the camera is zoomed out, the instanced render mode draws each chunk, or group of chunks, as a
+    /// single quad textured with its tiles baked ahead of time. Baked tiles are redrawn when their tiles change, but
+    /// show animated tiles frozen at the frame they were baked with.
     class TileMap final : public Object {
 
     public:
+        /// How the tiles of a tile map are drawn.
+        enum class RenderMode {
+            /// Draw the tiles of each visible chunk with one instanced draw call per chunk.
+            instanced,
+            /// Draw the visible area of the map as a single quad and look up the tile under each pixel from a texture
+            /// of tile IDs. The draw cost does not depend on the number of visible tiles.
+            tileIDTexture,
+            /// Keep the visible tiles in a wrap-around offscreen buffer slightly larger than the view and draw it as a
+            /// single quad. Only the rows and columns that scroll into view, and the chunks whose tiles change, are
+            /// drawn into the buffer, so panning over an unchanged map costs little more than one textured quad.
+            /// @note Animated tiles keep the frame they were drawn into the buffer with. Zoomed out views are drawn as
+            /// in the instanced render mode.
+            scrollBuffer
+        };
+
+        /// A read-only copy of the tiles of a tile map, see `snapshot`.
+        class Snapshot;
+
         /// Construct a `TileMap` object from a YAML file.
         /// @param yamlPath The path to a YAML formatted tile map document.
         /// @return A `TileMap` pointer.
         static std::unique_ptr<TileMap> create(const std::string& yamlPath);
 
+        /// The maximum number of tile layers in a tile map.
+        static constexpr int maxLayers{16};
+
         /// @param tileSheet The tile sheet.
         /// @param mapSize The size (width, height) of the tile map in tiles.
         /// @param tiles The tiles in the tile map by integer ID. Zero indicates an empty tile.
         TileMap(std::unique_ptr<TileSheet> tileSheet, glm::ivec2 mapSize, const std::vector<int>& tiles);
 
+        /// @note Throws if the tile sheet has more than `TileChunkBuffer::maxTileID` tiles, or if a tile ID is negative
+        /// or larger than the widest tile ID type can hold.
+        /// @param tileSheet The tile sheet.
+        /// @param mapSize The size (width, height) of the tile map in tiles.
+        /// @param layerCount The number of tile layers.
+        /// @param tiles The tiles of every layer by integer ID, stored layer by layer from the bottom layer up. Zero
+        /// indicates an empty tile.
+        TileMap(std::unique_ptr<TileSheet> tileSheet, glm::ivec2 mapSize, int layerCount,
+                const std::vector<int>& tiles);
+
         /// The size (width, height) of the tile map in tiles.
         [[nodiscard]] glm::ivec2 mapSize() const;
 
         /// Set the map size.
+        /// @note Tiles that fall outside the new map size are discarded. The remaining tiles are not copied for any
+        /// anchor, since other anchors than the bottom left move the grid coordinates the tiles are stored relative to
+        /// instead, so the cost scales with the discarded tiles rather than the map size.
         /// @param mapSize The new size (width, height) of the tile map in tiles.
-        void setMapSize(glm::ivec2 mapSize);
+        /// @param anchor The corner (or centre) of the map that stays in place, e.g., `Anchor::topRight` grows or
+        /// shrinks the map at its left and bottom edges.
+        void setMapSize(glm::ivec2 mapSize, Anchor anchor = Anchor::bottomLeft);
 
         /// The size (width and height) of a single tile in pixels.
         [[nodiscard]] glm::vec2 tileSize() const;
@@ -39,25 +93,199 @@ namespace TileEngine {
         /// Get the tile ID at the given map coordinates.
         /// @note Tile IDs are one-based and zero is reserved to indicate an empty tile.
         /// @param gridCoordinates The coordinates (row and column) of the tile to set.
+        /// @param layer The index of the tile layer, where zero is the bottom layer.
         /// @return the tile ID.
-        [[nodiscard]] int tileID(glm::ivec2 gridCoordinates) const;
+        [[nodiscard]] int tileID(glm::i64vec2 gridCoordinates, int layer = 0) const;
 
         /// Set the value of a given tile.
         /// @param gridCoordinates The coordinates (row and column) of the tile to set.
         /// @param tileID The value to set the tile to.
-        void setTileID(glm::ivec2 gridCoordinates, int tileID);
+        /// @param layer The index of the tile layer, where zero is the bottom layer.
+        void setTileID(glm::i64vec2 gridCoordinates, int tileID, int layer = 0);
+
+        /// Set every tile in a region to the same tile ID.
+        /// @note The tiles are written a chunk row at a time and change listeners see a single change for the region,
+        /// so this is much faster than setting the tiles one by one.
+        /// @param region The region in grid coordinates.
+        /// @param tileID The new tile ID, where zero empties the tiles.
+        /// @param layer The index of the tile layer, where zero is the bottom layer.
+        void fillRegion(const TileRegion& region, int tileID, int layer = 0);
+
+        /// Copy the tiles of a region from a tile map, which may be this tile map.
+        /// @note Overlapping regions of the same tile map are copied as if through a temporary buffer.
+        /// @param source The tile map to copy from.
+        /// @param sourceRegion The region to copy in the grid coordinates of the source tile map.
+        /// @param destination Where to copy the bottom left tile of the region to in grid coordinates.
+        /// @param sourceLayer The index of the tile layer to copy from.
+        /// @param destinationLayer The index of the tile layer to copy to.
+        void copyRegion(const TileMap& source, const TileRegion& sourceRegion, glm::i64vec2 destination,
+                        int sourceLayer = 0, int destinationLayer = 0);
+
+        /// Replace every occurrence of one tile ID with another within a region.
+        /// @param region The region in grid coordinates.
+        /// @param fromTileID The tile ID to replace. Zero replaces the empty tiles.
+        /// @param toTileID The tile ID to replace it with. Zero empties the tiles.
+        /// @param layer The index of the tile layer, where zero is the bottom layer.
+        void replaceInRegion(const TileRegion& region, int fromTileID, int toTileID, int layer = 0);
+
+        /// Count the tiles with a tile ID within a region.
+        /// @param region The region in grid coordinates.
+        /// @param tileID The tile ID to count. Zero counts the empty tiles.
+        /// @param layer The index of the tile layer, where zero is the bottom layer.
+        /// @return The number of tiles with the tile ID.
+        [[nodiscard]] std::int64_t countInRegion(const TileRegion& region, int tileID, int layer = 0) const;
+
+        /// Start keeping an index of where each tile ID is used, which speeds up `findTiles`, `replaceAll` and
+        /// `tileHistogram`.
+        /// @note Building the index reads every tile once. After that, `setTileID` and replacements update it in
+        /// constant time per changed chunk, and other region operations with one update per tile ID in each changed
+        /// chunk.
+        void enableTileIndex();
+
+        /// Whether an index of where each tile ID is used is kept, see `enableTileIndex`.
+        [[nodiscard]] bool tileIndexEnabled() const;
 
-        /// Get the tiles of the tile map as a flat list.
+        /// Find every tile with a tile ID.
+        /// @note With the tile index enabled only the chunks that contain the tile ID are searched, otherwise every
+        /// chunk is.
+        /// @param tileID A non-zero tile ID.
+        /// @param layer The index of the tile layer, where zero is the bottom layer.
+        /// @return The grid coordinates of the tiles, grouped by chunk.
+        [[nodiscard]] std::vector<glm::i64vec2> findTiles(int tileID, int layer = 0) const;
+
+        /// Replace every occurrence of one tile ID with another in a layer.
+        /// @note With the tile index enabled only the chunks that contain the tile ID are visited, otherwise every
+        /// chunk is.
+        /// @param fromTileID A non-zero tile ID to replace.
+        /// @param toTileID The tile ID to replace it with. Zero empties the tiles.
+        /// @param layer The index of the tile layer, where zero is the bottom layer.
+        void replaceAll(int fromTileID, int toTileID, int layer = 0);
+
+        /// Count how often each tile ID is used in a layer.
+        /// @note With the tile index enabled this does not read any tiles.
+        /// @param layer The index of the tile layer, where zero is the bottom layer.
+        /// @return Pairs of tile IDs and the number of tiles that use them, sorted by tile ID. Empty tiles and unused
+        /// tile IDs are left out.
+        [[nodiscard]] std::vector<std::pair<int, std::int64_t>> tileHistogram(int layer = 0) const;
+
+        /// Replace every tile that looks the same as an earlier tile in the tile sheet with that earlier tile (see
+        /// `TileSheet::canonicalTileID`), so that fewer distinct tile IDs are in use.
+        /// @note Animated tiles, and tiles that look the same as an animated tile, are left as they are.
+        /// @return The number of tiles that were replaced.
+        std::int64_t canonicalizeTileIDs();
+
+        /// Make chunks with identical tiles share memory, e.g., after generating a map with repeated rooms or large
+        /// uniform areas.
+        /// @note Shared chunks are copied when one of them is edited. Tile maps loaded from a file are deduplicated
+        /// when they are created.
+        /// @return The number of chunks that now share another chunk's memory.
+        std::size_t deduplicateChunks();
+
+        /// Get the most memory the tiles should take up before chunks are compressed.
+        /// @return The memory budget in bytes, or the largest `std::size_t` if there is no budget.
+        [[nodiscard]] std::size_t chunkMemoryBudget() const;
+
+        /// Set the most memory the tiles should take up.
+        /// @note Once the tiles use more memory than this, the least recently used chunks are compressed, e.g., the
+        /// chunks far from where the map is being edited. Chunks are checked about once a second. Compressed chunks
+        /// are decompressed when they are next changed or drawn, so resident memory follows the working set rather
+        /// than the size of the world. The budget is split evenly between the layers.
+        /// @param memoryBudget The memory budget in bytes. Pass the largest `std::size_t` to never compress chunks.
+        void setChunkMemoryBudget(std::size_t memoryBudget);
+
+        /// Get the chunk compression counters and memory use, summed over every layer.
+        [[nodiscard]] ChunkCacheStats chunkCacheStats() const;
+
+        /// Get the tiles of a layer within the map size as a flat list.
+        /// @param layer The index of the tile layer, where zero is the bottom layer.
         /// @return A list of tile IDs.
-        [[nodiscard]] std::vector<int> tiles() const;
+        [[nodiscard]] std::vector<int> tiles(int layer = 0) const;
+
+        /// Get the number of tile layers.
+        [[nodiscard]] int layerCount() const;
+
+        /// Add an empty tile layer on top of the existing layers.
+        /// @return The index of the new layer.
+        int addLayer();
+
+        /// Get whether a layer is drawn.
+        /// @param layer The index of the tile layer.
+        [[nodiscard]] bool layerVisible(int layer) const;
+
+        /// Show or hide a layer.
+        /// @param layer The index of the tile layer.
+        /// @param visible Whether the layer should be drawn.
+        void setLayerVisible(int layer, bool visible);
+
+        /// Get the opacity of a layer.
+        /// @param layer The index of the tile layer.
+        /// @return The opacity from zero (transparent) to one (opaque).
+        [[nodiscard]] float layerOpacity(int layer) const;
+
+        /// Set the opacity of a layer.
+        /// @param layer The index of the tile layer.
+        /// @param opacity The opacity from zero (transparent) to one (opaque).
+        void setLayerOpacity(int layer, float opacity);
+
+        /// Get the tile animations.
+        [[nodiscard]] const std::vector<TileAnimation>& animations() const;
+
+        /// Set the tile animations, replacing any existing animations.
+        /// @note Tiles store the ID of the animated tile and the shaders pick the current frame, so animating tiles
+        /// does not require updating any tile data.
+        /// @param animations The tile animations, at most one per tile ID.
+        void setAnimations(const std::vector<TileAnimation>& animations);
 
         /// Get the path to the image file used to create the underlying texture.
         [[nodiscard]] std::string texturePath() const;
 
+        /// Get the tile sheet the tiles are drawn from, e.g., to save how it was loaded.
+        [[nodiscard]] const TileSheet& tileSheet() const;
+
         /// Register a callback for when a tile is clicked.
+        /// @note The tile ID passed to the callback is from the bottom layer.
         /// @param callback A function that takes a grid coordinate (glm::vec2) and tile ID (int) as an argument.
         void addClickListener(const std::function<void(glm::ivec2 gridCoordinates, int tileID)>& callback);
 
+        /// Register a callback for changes to the tiles.
+        /// @note Changes are batched and the callback is called at most once per update with everything that changed
+        /// since the last update, rather than once per tile.
+        /// @param listener A function that takes the batched changes as an argument.
+        void addChangeListener(const TileChangeTracker::ChangeListener& listener);
+
+        /// Get the changes to the tiles that have not been sent to change listeners yet.
+        /// @return The dirty rectangles, chunks and layers since the last update.
+        [[nodiscard]] const TileChanges& pendingChanges() const;
+
+        /// Get how many times the tiles of a chunk have changed.
+        /// @note Caches built on the tile map can store the generation of each chunk they used and compare it later
+        /// to find out whether they are out of date.
+        /// @param chunkCoordinates The coordinates of a chunk (see `ChunkGrid::toChunkCoordinates`).
+        /// @return A number that increases every time a tile in the chunk changes, or zero if it never has.
+        [[nodiscard]] std::uint64_t chunkGeneration(glm::i64vec2 chunkCoordinates) const;
+
+        /// Get the most recently published copy of the tiles.
+        /// @note This may be called from any thread. The snapshot never changes, so it can be read without locking
+        /// while the tile map is edited. Hold on to the pointer for as long as a consistent view of the map is needed.
+        /// @return The tiles as of the last call to `publishSnapshot`.
+        [[nodiscard]] std::shared_ptr<const Snapshot> snapshot() const;
+
+        /// Publish the current tiles to readers on other threads (see `snapshot`).
+        /// @note This is called once per update. Chunks are shared between snapshots and the tile map, and a chunk is
+        /// only copied when the tile map changes a chunk that a snapshot still uses, so publishing costs
+        /// O(changed chunks) in tile data rather than a copy of the whole map.
+        /// @note Must be called from the thread that edits the tile map.
+        void publishSnapshot();
+
+        /// Get how the tiles are drawn.
+        [[nodiscard]] RenderMode renderMode() const;
+
+        /// Set how the tiles are drawn.
+        /// @note The tile ID texture render mode requires the map to fit in a single texture (see `GL_MAX_TEXTURE_SIZE`)
+        /// and the tile sheet to have at most `TileIDTexture::maxTileID` tiles.
+        /// @param renderMode The render mode to use.
+        void setRenderMode(RenderMode renderMode);
+
         /// Add grid lines over the tile map.
         void enableGridLines();
 
@@ -71,33 +299,329 @@ namespace TileEngine {
     private:
         /// Bounds of a tile grid.
         struct GridBounds {
-            int rowStart;
-            int rowEnd;
-            int colStart;
-            int colEnd;
+            std::int64_t rowStart;
+            std::int64_t rowEnd;
+            std::int64_t colStart;
+            std::int64_t colEnd;
         };
 
+        /// How much detail the tiles are drawn with, which depends on the camera zoom.
+        enum class DetailLevel {
+            /// Draw every tile.
+            tiles,
+            /// Draw each chunk from a baked texture.
+            chunks,
+            /// Draw each group of chunks (see `ChunkGrid::chunkGroupSize`) from a baked texture.
+            chunkGroups
+        };
+
+        /// A chunk to draw and its coordinates in the chunk grid.
+        using VisibleChunk = std::pair<glm::i64vec2, const TileChunkBuffer*>;
+
+        /// Baked textures keyed by chunk or chunk group coordinates.
+        using BakedTiles = std::unordered_map<glm::i64vec2, std::unique_ptr<RenderTexture>, ChunkCoordinatesHash>;
+
+        /// Storage for the tiles of a layer, using the narrowest tile ID type that fits the tile sheet.
+        using LayerStorage = std::variant<TileStorage<std::uint8_t>, TileStorage<std::uint16_t>>;
+
+        /// The tiles and display settings of a tile layer.
+        struct TileLayer {
+            /// The tile IDs.
+            LayerStorage tiles{};
+            /// Whether the layer is drawn.
+            bool visible{true};
+            /// The opacity from zero (transparent) to one (opaque).
+            float opacity{1.0f};
+        };
+
+        /// Switch a layer to a wider tile ID type if a tile ID does not fit its current one.
+        /// @param layer The index of the tile layer.
+        /// @param tileID The largest tile ID about to be written to the layer.
+        void widenLayerStorage(int layer, int tileID);
+
+        /// Move the tiles of every layer by moving the grid origin, without touching the tiles themselves.
+        /// @param offset The offset (columns, rows) to move the tiles by.
+        void translateTiles(glm::i64vec2 offset);
+
+        /// Convert grid coordinates to the coordinates the tiles are stored under, see `m_gridOrigin`.
+        /// @param gridCoordinates The grid coordinates (column, row).
+        /// @return The coordinates (column, row) in the tile storage.
+        [[nodiscard]] glm::i64vec2 storageCoordinates(glm::i64vec2 gridCoordinates) const;
+
+        /// Change the tiles of a region of a layer and keep the tile index up to date.
+        /// @note The tiles of the region are counted before and after the change, so the index is only updated for
+        /// the tile IDs in the changed chunks rather than tile by tile.
+        /// @param layer The index of the tile layer.
+        /// @param region The region that may change in grid coordinates.
+        /// @param change A function that changes the tiles of the layer and returns the coordinates of the changed
+        /// chunks.
+        /// @return The coordinates of the changed chunks.
+        std::vector<glm::i64vec2> changeRegion(int layer, const TileRegion& region,
+                                               const std::function<std::vector<glm::i64vec2>(LayerStorage&)>& change);
+
+        /// Get every tile ID of a chunk, including empty tiles.
+        /// @param layer The index of the tile layer.
+        /// @param chunkCoordinates The coordinates of the chunk.
+        /// @return The tile IDs in row-major order.
+        [[nodiscard]] std::vector<int> chunkTileIDs(int layer, glm::i64vec2 chunkCoordinates) const;
+
+        /// Get the coordinates of every chunk stored in a layer.
+        /// @param layer The index of the tile layer.
+        [[nodiscard]] std::vector<glm::i64vec2> storedChunks(int layer) const;
+
+        /// Record that the tiles of a region have changed, e.g., to reload the changed chunks and notify listeners.
+        /// @param region The region that was written to in grid coordinates.
+        /// @param layer The index of the tile layer.
+        /// @param changedChunks The coordinates of the chunks whose tiles changed.
+        void onRegionChanged(const TileRegion& region, int layer, const std::vector<glm::i64vec2>& changedChunks);
+
+        /// Create empty layer storage with the narrowest tile ID type that can hold every tile ID in the tile sheet.
+        /// @param largestTileID The largest tile ID the storage must hold, e.g., of tiles loaded from a file.
+        [[nodiscard]] LayerStorage createLayerStorage(int largestTileID = 0) const;
+
+        /// Get the tiles of every layer within the map size, stored layer by layer (bottom layer first).
+        [[nodiscard]] std::vector<int> tilesOfAllLayers() const;
+
+        /// Get the opacity each layer should be drawn with, where hidden layers are fully transparent.
+        /// @return One opacity per layer.
+        [[nodiscard]] std::vector<float> effectiveLayerOpacities() const;
+
+        /// Work out which tile IDs can be drawn without blending from the tile sheet and the tile animations.
+        void updateTileOpacities();
+
+        /// Whether a tile on a layer can be drawn without blending.
+        /// @param tileID The ID of the tile.
+        /// @param layer The index of the tile layer.
+        [[nodiscard]] bool drawsOpaque(int tileID, int layer) const;
+
+        /// Whether a tile on a layer completely hides the tiles on the layers below it.
+        /// @param tileID The ID of the tile.
+        /// @param layer The index of the tile layer.
+        [[nodiscard]] bool hidesTilesBelow(int tileID, int layer) const;
+
+        /// Whether a tile is fully transparent in every frame, so that it never needs to be drawn.
+        /// @param tileID The ID of the tile.
+        [[nodiscard]] bool isInvisible(int tileID) const;
+
+        /// Whether a tile ID has an animation.
+        [[nodiscard]] bool isAnimated(int tileID) const;
+
+        /// Compress the least recently used chunks of each layer until the tiles fit in the chunk memory budget.
+        void compressColdChunks();
+
+        /// Mark every chunk that has tiles or a buffer as needing its buffer to be reloaded.
+        void markAllChunksDirty();
+
         /// Find the area of the tile map visible to a camera.
         /// @param camera The camera to use for calculating visible tile maps.
         /// @return The visible area of the tile map.
         [[nodiscard]] GridBounds calculateVisibleGridBounds(const Camera& camera) const;
 
+        /// Set the uniforms and bind the textures for looking up animation frames.
+        /// @param shader The shader to set the uniforms of.
+        void bindAnimations(const Shader& shader) const;
+
+        /// Get the transform from grid coordinates to world coordinates.
+        [[nodiscard]] glm::mat4 gridTransform() const;
+
+        /// Find the chunks with tiles to draw within an area.
+        /// @param bounds The visible area of the tile map in grid coordinates.
+        /// @return The visible chunks, by their coordinates in the tile storage.
+        [[nodiscard]] std::vector<VisibleChunk> findVisibleChunks(const GridBounds& bounds) const;
+
+        /// Draw chunks with instancing.
+        /// @param chunks The chunks to draw, by their coordinates in the tile storage.
+        /// @param projectionViewMatrix The projection view matrix to draw with.
+        /// @param transform The transform from grid coordinates to world coordinates.
+        void renderChunks(const std::vector<VisibleChunk>& chunks, const glm::mat4& projectionViewMatrix,
+                          const glm::mat4& transform) const;
+
+        /// Draw the tiles with instancing, or from baked textures when zoomed out.
+        /// @param graphics The graphics object to render the tile map with.
+        /// @param bounds The visible area of the tile map.
+        void renderInstanced(const Graphics& graphics, const GridBounds& bounds) const;
+
+        /// Get how much detail to draw tiles with.
+        /// @param camera The camera the tile map is viewed with.
+        [[nodiscard]] static DetailLevel detailLevel(const Camera& camera);
+
+        /// Bake any visible chunks or chunk groups that the current detail level needs and are not baked yet.
+        /// @note At most `maxBakesPerUpdate` are baked per call and at most `maxBakedTextures` are kept, so some
+        /// visible chunks may be left unbaked for now.
+        /// @param camera The camera the tile map is viewed with.
+        void bakeVisibleChunks(const Camera& camera);
+
+        /// Draw the tiles of a square block of chunks into a texture.
+        /// @param firstChunk The coordinates (column, row) of the bottom left chunk in the tile storage.
+        /// @param chunksAcross The width and height of the block in chunks.
+        /// @return The baked texture with premultiplied alpha.
+        [[nodiscard]] std::unique_ptr<RenderTexture> bakeTiles(glm::i64vec2 firstChunk, int chunksAcross) const;
+
+        /// Draw the tiles that have come into view or changed into the scroll buffer.
+        /// @param camera The camera the tile map is viewed with.
+        void updateScrollBuffer(const Camera& camera);
+
+        /// Draw the tiles of a region into the scroll buffer, wrapping around its edges.
+        /// @param region The region in grid coordinates. It must fit within the scroll buffer.
+        void drawToScrollBuffer(const GridBounds& region) const;
+
+        /// Draw the visible part of the scroll buffer.
+        /// @param graphics The graphics object to render the tile map with.
+        /// @param bounds The visible area of the tile map.
+        void renderScrollBuffer(const Graphics& graphics, const GridBounds& bounds) const;
+
+        /// Discard the baked textures and the parts of the scroll buffer that contain a chunk.
+        /// @param chunkCoordinates The coordinates (column, row) of the chunk.
+        void invalidateBakedTiles(glm::i64vec2 chunkCoordinates);
+
+        /// Draw the visible baked chunks or chunk groups, and the visible chunks that are not baked tile by tile.
+        /// @param graphics The graphics object to render the tile map with.
+        /// @param bounds The visible area of the tile map.
+        /// @param bakedTiles The baked textures to draw.
+        /// @param chunksAcross The width and height of each baked texture in chunks.
+        void renderBakedTiles(const Graphics& graphics, const GridBounds& bounds, const BakedTiles& bakedTiles,
+                              int chunksAcross) const;
+
+        /// Draw the visible area of the tile map with a single quad that looks up tiles from the tile ID texture.
+        /// @param graphics The graphics object to render the tile map with.
+        /// @param bounds The visible area of the tile map.
+        void renderTileIDTexture(const Graphics& graphics, const GridBounds& bounds) const;
+
+        /// Reload the chunk buffers of any chunks whose tiles have changed.
+        void loadDirtyChunks();
+
+        /// Regenerate the instance data for a chunk and upload it to the GPU.
+        /// @note The chunk's buffer is created on demand and released once the chunk has nothing to draw. Tiles that
+        /// are hidden under a fully opaque tile on a higher layer are left out.
+        /// @param chunkCoordinates The coordinates (column, row) of the chunk in the chunk grid.
+        void loadChunk(glm::i64vec2 chunkCoordinates);
+
+        /// The width and height of a chunk in tiles.
+        static constexpr int chunkSize{ChunkGrid::chunkSize};
+
         /// The tile sheet.
         const std::unique_ptr<TileSheet> m_tileSheet;
         /// The size (width, height) of the tile map in tiles.
         glm::ivec2 m_mapSize;
-        /// The tiles of the tile map.
-        std::vector<int> m_tiles;
+        /// The tile layers from the bottom layer up.
+        std::vector<TileLayer> m_layers;
+        /// The grid coordinates of the tile stored at (0, 0), which moves when the map is resized from another anchor
+        /// than the bottom left so that the tiles do not have to.
+        /// @note The chunk buffers, baked tiles and tile index use the chunk coordinates of the tile storage, while
+        /// change listeners see the chunk coordinates of the grid (see `ChunkGrid::toChunkCoordinates`).
+        glm::i64vec2 m_gridOrigin{0};
 
         /// Shader to render textured tiles.
-        const Shader m_shader{Shader::create("resource/shader/tile.vert", "resource/shader/tile.frag")};
-        /// The tile geometry.
-        const Quad m_quad{};
+        /// @note Depends on whether the tile sheet uses a texture array.
+        const Shader m_shader;
+        /// The GPU buffers of the chunks that have tiles to draw.
+        std::unordered_map<glm::i64vec2, std::unique_ptr<TileChunkBuffer>, ChunkCoordinatesHash> m_chunkBuffers{};
+        /// The chunks whose tiles have changed since their buffers were last loaded.
+        std::unordered_set<glm::i64vec2, ChunkCoordinatesHash> m_dirtyChunks{};
+
+        /// How the tiles are drawn.
+        RenderMode m_renderMode{RenderMode::instanced};
+        /// Shader to render the tile map from the tile ID texture.
+        /// @note Depends on whether the tile sheet uses a texture array.
+        const Shader m_tileIDShader;
+        /// The tile IDs as a texture.
+        /// @note Only created for the tile ID texture render mode.
+        std::unique_ptr<TileIDTexture> m_tileIDTexture{};
+
+        /// Shader to render baked chunks and chunk groups.
+        const Shader m_bakedTilesShader;
+        /// The baked textures of single chunks.
+        BakedTiles m_bakedChunks{};
+        /// The baked textures of chunk groups.
+        BakedTiles m_bakedChunkGroups{};
+
+        /// Shader to render the scroll buffer.
+        const Shader m_scrollBufferShader;
+        /// The wrap-around buffer of visible tiles, where the tile at grid coordinates (col, row) is stored at
+        /// (col mod width, row mod height).
+        /// @note Only created for the scroll buffer render mode.
+        std::unique_ptr<RenderTexture> m_scrollBuffer{};
+        /// The width and height of the scroll buffer in tiles.
+        glm::ivec2 m_scrollBufferTiles{};
+        /// The area of the tile map that is up to date in the scroll buffer, if any.
+        std::optional<GridBounds> m_scrollBufferBounds{};
+        /// The chunks that have been reloaded since the scroll buffer was last updated.
+        std::vector<glm::i64vec2> m_staleScrollBufferChunks{};
+
+        /// The tile animations.
+        std::vector<TileAnimation> m_animations{};
+        /// The opacity of each tile ID, where an animated tile is as see-through as its most see-through frame.
+        /// @note Indexed by tile ID, so the first element is unused.
+        std::vector<TileSheet::TileOpacity> m_tileOpacities{};
+        /// The tile animations on the GPU.
+        /// @note Only created while there are tile animations.
+        std::unique_ptr<TileAnimationTable> m_animationTable{};
+        /// The time since the tile map was created in seconds, used to pick the current animation frames.
+        double m_animationTime{0.0};
 
         /// Optional grid lines to draw over the tile map.
         std::optional<GridLines> m_gridLines{};
         /// Functions to be called when a tile is clicked.
         std::vector<std::function<void(glm::ivec2 gridCoordinates, int tileID)>> m_clickListeners;
+        /// The changes to the tiles, which are sent to change listeners once per update.
+        TileChangeTracker m_changes{};
+        /// The most memory the tiles should take up in bytes before chunks are compressed.
+        std::size_t m_chunkMemoryBudget{std::numeric_limits<std::size_t>::max()};
+        /// The animation time when chunks were last compressed.
+        double m_lastChunkCompressionTime{0.0};
+        /// The index of where each tile ID is used, one per layer.
+        /// @note Empty unless the tile index is enabled.
+        std::vector<TileIndex> m_tileIndices{};
+        /// A bit mask of the layers that have changed since the last snapshot was published.
+        std::uint32_t m_unpublishedLayers{0};
+        /// The most recently published snapshot, which readers on other threads load.
+        std::atomic<std::shared_ptr<const Snapshot>> m_snapshot{};
+    };
+
+    /// A read-only copy of the tiles of a tile map at the time it was published.
+    /// @note Snapshots share unchanged chunks with the tile map and with each other, and are never changed once
+    /// published, so any number of threads may read one at the same time.
+    class TileMap::Snapshot {
+    public:
+        /// @param mapSize The size (width, height) of the tile map in tiles.
+        /// @param gridOrigin The grid coordinates of the tile stored at (0, 0).
+        /// @param layers The tiles of each layer.
+        /// @param generation The number of snapshots published before this one plus one.
+        Snapshot(glm::ivec2 mapSize, glm::i64vec2 gridOrigin, std::vector<std::shared_ptr<const LayerStorage>> layers,
+                 std::uint64_t generation);
+
+        /// The size (width, height) of the tile map in tiles.
+        [[nodiscard]] glm::ivec2 mapSize() const;
+
+        /// Get the number of tile layers.
+        [[nodiscard]] int layerCount() const;
+
+        /// Get the value of a given tile.
+        /// @param gridCoordinates The coordinates (column, row) of the tile.
+        /// @param layer The index of the tile layer, where zero is the bottom layer.
+        /// @return The tile ID, or zero if the tile is empty.
+        [[nodiscard]] int tileID(glm::i64vec2 gridCoordinates, int layer = 0) const;
+
+        /// Get the tiles of a layer within the map size as a flat list.
+        /// @param layer The index of the tile layer, where zero is the bottom layer.
+        /// @return A list of tile IDs.
+        [[nodiscard]] std::vector<int> tiles(int layer = 0) const;
+
+        /// Get the number of snapshots published up to and including this one, which increases with every snapshot.
+        [[nodiscard]] std::uint64_t generation() const;
+
+    private:
+        // Lets the tile map share unchanged layers with the previous snapshot when publishing.
+        friend class TileMap;
+
+        /// The size (width, height) of the tile map in tiles.
+        const glm::ivec2 m_mapSize;
+        /// The grid coordinates of the tile stored at (0, 0).
+        const glm::i64vec2 m_gridOrigin;
+        /// The tiles of each layer, where layers that did not change are shared with the previous snapshot.
+        const std::vector<std::shared_ptr<const LayerStorage>> m_layers;
+        /// The number of snapshots published up to and including this one.
+        const std::uint64_t m_generation;
     };
 } // namespace TileEngine
 
@@ -1,42 +1,480 @@
 
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "glad/glad.h"
+#include "yaml-cpp/yaml.h"
+
 #include <TileEngine//TileSheet.hpp>
 
 namespace TileEngine {
     namespace {
-        glm::vec2 calculateSheetSize(const Texture* texture, const glm::vec2 tileSize) {
-            return static_cast<glm::vec2>(texture->resolution()) / tileSize;
+        glm::vec2 calculateSheetSize(const glm::ivec2 resolution, const glm::vec2 tileSize) {
+            return static_cast<glm::vec2>(resolution) / tileSize;
         }
 
         /// Generate the texture coordinates for a tile sheet.
-        /// @note The UV coordinates are returned as a flat array, however each tile's coordinates take up 4 consecutive
-        /// elements.
         /// @param sheetSize The width and height of the tile sheet in tiles.
-        /// @return The UV coordinates for each tile (four elements each).
-        std::vector<glm::vec2> generateTextureCoordinates(const glm::ivec2 sheetSize) {
-            const auto width{1.0f / static_cast<float>(sheetSize.x)};
-            const auto height{1.0f / static_cast<float>(sheetSize.y)};
-
+        /// @param stride The distance between neighbouring tiles in texture coordinates.
+        /// @param inset The offset from the corner of a padded cell to its tile in texture coordinates.
+        /// @return The UV coordinates of the bottom left corner of each tile.
+        std::vector<glm::vec2> generateTextureCoordinates(const glm::ivec2 sheetSize, const glm::vec2 stride,
+                                                          const glm::vec2 inset) {
             std::vector<glm::vec2> textureCoordinates{};
             textureCoordinates.reserve(sheetSize.x * sheetSize.y);
 
             for (int row = 0; row < sheetSize.y; ++row) {
                 for (int col = 0; col < sheetSize.x; ++col) {
-                    const auto u{static_cast<float>(col) * width};
-                    const auto v{static_cast<float>(row) * height};
-
-                    textureCoordinates.emplace_back(u, v);
+                    textureCoordinates.push_back(glm::vec2{col, row} * stride + inset);
                 }
             }
 
             return textureCoordinates;
         }
+
+        /// Get the offset from the corner of a padded cell to the tile centred in it.
+        /// @param tileResolution The width and height of a tile in pixels.
+        /// @param cellResolution The width and height of a cell in pixels.
+        /// @return The offset in pixels, which is the gutter on the left and bottom sides of the tile.
+        glm::ivec2 cellInset(const glm::ivec2 tileResolution, const glm::ivec2 cellResolution) {
+            return (cellResolution - tileResolution) / 2;
+        }
+
+        /// Copy each tile of an image into the middle of a larger cell, and fill the rest of the cell by repeating the
+        /// tile's edge pixels outwards.
+        /// @param image An image containing a regular grid of tiles.
+        /// @param tileResolution The width and height of a tile in pixels.
+        /// @param cellResolution The width and height of a cell in pixels.
+        /// @return An image with the same grid of tiles, where each tile takes up a cell.
+        Image::Image extrudeTiles(const Image::Image& image, const glm::ivec2 tileResolution,
+                                  const glm::ivec2 cellResolution) {
+            const int channels{image.channels};
+            const glm::ivec2 sheetSize{image.resolution / tileResolution};
+            const glm::ivec2 atlasResolution{sheetSize * cellResolution};
+            const glm::ivec2 inset{cellInset(tileResolution, cellResolution)};
+            std::vector<std::uint8_t> bytes(static_cast<std::size_t>(atlasResolution.x) * atlasResolution.y * channels);
+
+            for (int row = 0; row < sheetSize.y; ++row) {
+                for (int col = 0; col < sheetSize.x; ++col) {
+                    for (int cellRow = 0; cellRow < cellResolution.y; ++cellRow) {
+                        // Rows of the gutter repeat the nearest row of the tile.
+                        const int tileRow{std::clamp(cellRow - inset.y, 0, tileResolution.y - 1)};
+                        const auto source{image.bytes.begin() +
+                                          (static_cast<std::ptrdiff_t>(row * tileResolution.y + tileRow) *
+                                               image.resolution.x +
+                                           col * tileResolution.x) *
+                                              channels};
+                        const auto destination{bytes.begin() +
+                                               (static_cast<std::ptrdiff_t>(row * cellResolution.y + cellRow) *
+                                                    atlasResolution.x +
+                                                col * cellResolution.x) *
+                                                   channels};
+                        const auto lastPixel{source + (tileResolution.x - 1) * channels};
+
+                        for (int cellCol = 0; cellCol < inset.x; ++cellCol) {
+                            std::copy_n(source, channels, destination + cellCol * channels);
+                        }
+
+                        std::copy_n(source, tileResolution.x * channels, destination + inset.x * channels);
+
+                        for (int cellCol = inset.x + tileResolution.x; cellCol < cellResolution.x; ++cellCol) {
+                            std::copy_n(lastPixel, channels, destination + cellCol * channels);
+                        }
+                    }
+                }
+            }
+
+            return {.bytes = bytes, .resolution = atlasResolution, .channels = channels, .path = image.path};
+        }
+
+        /// Scan the alpha channel of a single tile.
+        /// @param image An image with an alpha channel.
+        /// @param origin The coordinates (column, row) of the tile's first pixel.
+        /// @param tileResolution The width and height of a tile in pixels.
+        /// @return The opacity of the tile.
+        TileSheet::TileOpacity classifyTile(const Image::Image& image, const glm::ivec2 origin,
+                                            const glm::ivec2 tileResolution) {
+            constexpr int alphaChannel{3};
+            bool anyTransparent{false};
+            bool anyVisible{false};
+
+            for (int row = origin.y; row < origin.y + tileResolution.y; ++row) {
+                for (int col = origin.x; col < origin.x + tileResolution.x; ++col) {
+                    const std::size_t pixelIndex{static_cast<std::size_t>(row) * image.resolution.x + col};
+                    const std::uint8_t alpha{image.bytes[pixelIndex * image.channels + alphaChannel]};
+
+                    if (alpha == 0) {
+                        anyTransparent = true;
+                    } else if (alpha != 255) {
+                        return TileSheet::TileOpacity::translucent;
+                    } else {
+                        anyVisible = true;
+                    }
+                }
+            }
+
+            if (!anyVisible) {
+                return TileSheet::TileOpacity::empty;
+            }
+
+            return anyTransparent ? TileSheet::TileOpacity::cutout : TileSheet::TileOpacity::opaque;
+        }
+
+        /// Hash bytes with 64-bit FNV-1a, which gives the same hash on every platform and run.
+        /// @param bytes The bytes to hash.
+        /// @param hash The hash of the bytes that came before, to hash several ranges as one.
+        /// @return The hash of all of the bytes so far.
+        std::uint64_t hashBytes(const std::span<const std::uint8_t> bytes,
+                                std::uint64_t hash = 14695981039346656037ull) {
+            for (const std::uint8_t byte : bytes) {
+                hash = (hash ^ byte) * 1099511628211ull;
+            }
+
+            return hash;
+        }
+
+        /// Get the pixel bytes of one row of a tile.
+        /// @param image An image containing a regular grid of tiles.
+        /// @param origin The coordinates (column, row) of the tile's first pixel.
+        /// @param tileResolution The width and height of a tile in pixels.
+        /// @param row The row of the tile.
+        std::span<const std::uint8_t> tileRow(const Image::Image& image, const glm::ivec2 origin,
+                                              const glm::ivec2 tileResolution, const int row) {
+            const std::size_t rowStart{
+                (static_cast<std::size_t>(origin.y + row) * image.resolution.x + origin.x) * image.channels};
+
+            const std::size_t rowLength{static_cast<std::size_t>(tileResolution.x) * image.channels};
+
+            return std::span{image.bytes}.subspan(rowStart, rowLength);
+        }
+
+        /// Get the path of the file that the tile analysis of an image is cached in.
+        std::filesystem::path tileAnalysisCachePath(const Image::Image& image) {
+            return std::filesystem::path{image.path + ".tiles.yaml"};
+        }
+
+        /// Get a stamp that changes whenever an image file is changed, to tell whether a cached analysis is stale.
+        /// @return The size of the file and its last modification time, or nothing if the file cannot be found.
+        std::optional<std::pair<std::uintmax_t, std::int64_t>> imageFileStamp(const Image::Image& image) {
+            std::error_code error{};
+            const std::uintmax_t fileSize{std::filesystem::file_size(image.path, error)};
+
+            if (error) {
+                return std::nullopt;
+            }
+
+            const auto lastWriteTime{std::filesystem::last_write_time(image.path, error)};
+
+            if (error) {
+                return std::nullopt;
+            }
+
+            return std::pair{fileSize, static_cast<std::int64_t>(lastWriteTime.time_since_epoch().count())};
+        }
     } // namespace
 
-    TileSheet::TileSheet(std::unique_ptr<Texture> texture, const glm::vec2 tileSize) :
-        m_texture(std::move(texture)), m_tileSize(tileSize),
-        m_sheetSize(calculateSheetSize(m_texture.get(), m_tileSize)), m_textureCoordinateStride(1.0f / m_sheetSize),
-        m_textureCoordinates(generateTextureCoordinates(m_sheetSize)) {
+    std::unique_ptr<TileSheet> TileSheet::create(const Image::Image& image, const glm::vec2 tileSize) {
+        return std::make_unique<TileSheet>(Texture::create(image), tileSize, loadTileAnalysis(image, tileSize));
+    }
+
+    std::unique_ptr<TileSheet> TileSheet::createMipmapped(const Image::Image& image, const glm::vec2 tileSize,
+                                                          const int minGutter) {
+        assert(minGutter > 0 and "Mipmapped tiles need a gutter.");
+
+        const glm::ivec2 tileResolution{tileSize};
+        // Power-of-two cells keep the texels of every mipmap level from straddling two cells.
+        const glm::ivec2 cellResolution{
+            static_cast<int>(std::bit_ceil(static_cast<unsigned int>(tileResolution.x + 2 * minGutter))),
+            static_cast<int>(std::bit_ceil(static_cast<unsigned int>(tileResolution.y + 2 * minGutter)))};
+        const glm::ivec2 inset{cellInset(tileResolution, cellResolution)};
+
+        // A texel at level `n` covers 2^n pixels of the full-size texture, so it stays within the gutter while 2^n is
+        // no wider than the narrowest side of the gutter.
+        const int narrowestGutter{std::min(inset.x, inset.y)};
+        const int maxMipmapLevel{static_cast<int>(std::bit_width(static_cast<unsigned int>(narrowestGutter))) - 1};
+
+        std::unique_ptr texture{Texture::create(extrudeTiles(image, tileResolution, cellResolution))};
+        texture->enableMipmaps(maxMipmapLevel);
+
+        return std::make_unique<TileSheet>(std::move(texture), tileSize, loadTileAnalysis(image, tileSize),
+                                           glm::vec2{cellResolution});
+    }
+
+    std::vector<TileSheet::TileOpacity> TileSheet::classifyTiles(const Image::Image& image, const glm::vec2 tileSize) {
+        const glm::ivec2 tileResolution{tileSize};
+        const glm::ivec2 sheetSize{calculateSheetSize(image.resolution, tileSize)};
+
+        // Images without an alpha channel are fully opaque.
+        if (image.channels != 4) {
+            return std::vector(sheetSize.x * sheetSize.y, TileOpacity::opaque);
+        }
+
+        std::vector<TileOpacity> tileOpacities{};
+        tileOpacities.reserve(sheetSize.x * sheetSize.y);
+
+        // Tile IDs count along the rows of the image in the same order as the texture coordinates.
+        for (int row = 0; row < sheetSize.y; ++row) {
+            for (int col = 0; col < sheetSize.x; ++col) {
+                tileOpacities.push_back(classifyTile(image, glm::ivec2{col, row} * tileResolution, tileResolution));
+            }
+        }
+
+        return tileOpacities;
+    }
+
+    TileSheet::TileAnalysis TileSheet::analyzeTiles(const Image::Image& image, const glm::vec2 tileSize) {
+        const glm::ivec2 tileResolution{tileSize};
+        const glm::ivec2 sheetSize{calculateSheetSize(image.resolution, tileSize)};
+
+        TileAnalysis analysis{.tileOpacities = classifyTiles(image, tileSize), .canonicalTileIDs = {}};
+        analysis.canonicalTileIDs.reserve(analysis.tileOpacities.size());
+
+        // Tiles are bucketed by the hash of their pixels and only compared byte for byte within a bucket.
+        std::unordered_map<std::uint64_t, std::vector<int>> tilesByHash{};
+        int firstEmptyTileID{0};
+
+        for (int row = 0; row < sheetSize.y; ++row) {
+            for (int col = 0; col < sheetSize.x; ++col) {
+                const int tileID{static_cast<int>(analysis.canonicalTileIDs.size()) + 1};
+                const glm::ivec2 origin{glm::ivec2{col, row} * tileResolution};
+
+                // The colour of fully transparent pixels is never seen, so every empty tile looks the same.
+                if (analysis.tileOpacities[tileID - 1] == TileOpacity::empty) {
+                    firstEmptyTileID = firstEmptyTileID == 0 ? tileID : firstEmptyTileID;
+                    analysis.canonicalTileIDs.push_back(firstEmptyTileID);
+                    continue;
+                }
+
+                std::uint64_t hash{hashBytes(tileRow(image, origin, tileResolution, 0))};
+
+                for (int tileRowIndex = 1; tileRowIndex < tileResolution.y; ++tileRowIndex) {
+                    hash = hashBytes(tileRow(image, origin, tileResolution, tileRowIndex), hash);
+                }
+
+                std::vector<int>& candidates{tilesByHash[hash]};
+                const auto match{std::ranges::find_if(candidates, [&](const int candidateID) {
+                    const glm::ivec2 candidateOrigin{
+                        glm::ivec2{(candidateID - 1) % sheetSize.x, (candidateID - 1) / sheetSize.x} * tileResolution};
+
+                    return std::ranges::all_of(std::views::iota(0, tileResolution.y), [&](const int tileRowIndex) {
+                        return std::ranges::equal(tileRow(image, origin, tileResolution, tileRowIndex),
+                                                  tileRow(image, candidateOrigin, tileResolution, tileRowIndex));
+                    });
+                })};
+
+                if (match == candidates.end()) {
+                    candidates.push_back(tileID);
+                    analysis.canonicalTileIDs.push_back(tileID);
+                } else {
+                    analysis.canonicalTileIDs.push_back(*match);
+                }
+            }
+        }
+
+        return analysis;
+    }
+
+    TileSheet::TileAnalysis TileSheet::loadTileAnalysis(const Image::Image& image, const glm::vec2 tileSize) {
+        const std::optional fileStamp{imageFileStamp(image)};
+
+        // Images that were not loaded from a file have nowhere to keep a cache.
+        if (!fileStamp.has_value()) {
+            return analyzeTiles(image, tileSize);
+        }
+
+        const glm::ivec2 sheetSize{calculateSheetSize(image.resolution, tileSize)};
+        const std::size_t tileCount{static_cast<std::size_t>(sheetSize.x) * sheetSize.y};
+        const std::filesystem::path cachePath{tileAnalysisCachePath(image)};
+
+        try {
+            if (std::filesystem::exists(cachePath)) {
+                const YAML::Node cache{YAML::LoadFile(cachePath.string())};
+                const YAML::Node tileSizeNode{cache["tile-size"]};
+                const auto opacities{cache["tile-opacities"].as<std::vector<int>>()};
+                auto canonicalTileIDs{cache["canonical-tiles"].as<std::vector<int>>()};
+
+                // A hand-edited or corrupt cache must not produce invalid opacities or tile IDs, so each tile may only
+                // be a copy of itself or of an earlier tile.
+                const bool validOpacities{std::ranges::all_of(opacities, [](const int opacity) {
+                    return opacity >= static_cast<int>(TileOpacity::empty) and
+                           opacity <= static_cast<int>(TileOpacity::translucent);
+                })};
+                const bool validCanonicalTileIDs{std::ranges::all_of(
+                    std::views::iota(std::size_t{0}, canonicalTileIDs.size()), [&](const std::size_t index) {
+                        const int canonicalTileID{canonicalTileIDs[index]};
+                        return canonicalTileID >= 1 and static_cast<std::size_t>(canonicalTileID) <= index + 1;
+                    })};
+
+                if (cache["file-size"].as<std::uintmax_t>() == fileStamp->first and
+                    cache["modified"].as<std::int64_t>() == fileStamp->second and
+                    tileSizeNode["width"].as<int>() == static_cast<int>(tileSize.x) and
+                    tileSizeNode["height"].as<int>() == static_cast<int>(tileSize.y) and
+                    opacities.size() == tileCount and canonicalTileIDs.size() == tileCount and validOpacities and
+                    validCanonicalTileIDs) {
+                    TileAnalysis analysis{.tileOpacities = {}, .canonicalTileIDs = std::move(canonicalTileIDs)};
+                    std::ranges::transform(opacities, std::back_inserter(analysis.tileOpacities),
+                                           [](const int opacity) { return static_cast<TileOpacity>(opacity); });
+
+                    return analysis;
+                }
+            }
+        } catch (const YAML::Exception&) {
+            // A cache that cannot be read is replaced below.
+        }
+
+        TileAnalysis analysis{analyzeTiles(image, tileSize)};
+        std::vector<int> opacities{};
+        std::ranges::transform(analysis.tileOpacities, std::back_inserter(opacities),
+                               [](const TileOpacity opacity) { return static_cast<int>(opacity); });
+
+        YAML::Emitter yamlOut{};
+
+        yamlOut << YAML::BeginDoc;
+        yamlOut << YAML::BeginMap;
+        yamlOut << YAML::Key << "file-size" << YAML::Value << fileStamp->first << YAML::Comment("in bytes");
+        yamlOut << YAML::Key << "modified" << YAML::Value << fileStamp->second;
+        yamlOut << YAML::Key << "tile-size" << YAML::Comment("in pixels");
+        yamlOut << YAML::Value;
+        {
+            yamlOut << YAML::BeginMap;
+            yamlOut << YAML::Key << "width" << YAML::Value << static_cast<int>(tileSize.x);
+            yamlOut << YAML::Key << "height" << YAML::Value << static_cast<int>(tileSize.y);
+            yamlOut << YAML::EndMap; // tile-size
+        }
+        yamlOut << YAML::Key << "tile-opacities" << YAML::Comment("0 = empty, 1 = opaque, 2 = cutout, 3 = translucent");
+        yamlOut << YAML::Value << YAML::Flow << opacities;
+        yamlOut << YAML::Key << "canonical-tiles" << YAML::Value << YAML::Flow << analysis.canonicalTileIDs;
+        yamlOut << YAML::EndMap;
+        yamlOut << YAML::EndDoc;
+
+        // The cache only saves time, so a read-only directory is not an error.
+        if (std::ofstream cacheFile{cachePath}; cacheFile) {
+            cacheFile << yamlOut.c_str() << std::endl;
+        }
+
+        return analysis;
+    }
+
+    std::unique_ptr<TileSheet> TileSheet::createTextureArray(const Image::Image& image, const glm::vec2 tileSize) {
+        return createTextureArray(std::vector{image}, tileSize);
+    }
+
+    std::unique_ptr<TileSheet> TileSheet::createTextureArray(const std::vector<Image::Image>& images,
+                                                             const glm::vec2 tileSize) {
+        if (images.empty()) {
+            throw std::runtime_error("A tile sheet needs at least one image.");
+        }
+
+        const glm::ivec2 tileResolution{tileSize};
+        const int channels{images.front().channels};
+
+        std::vector<SourceImage> sourceImages{};
+        TileAnalysis tileAnalysis{};
+        int tileCount{0};
+
+        for (const auto& image : images) {
+            if (image.channels != channels) {
+                throw std::runtime_error(std::format("The image {0} has {1} channels, but {2} channels were expected.",
+                                                     image.path, image.channels, channels));
+            }
+
+            const glm::ivec2 sheetSize{calculateSheetSize(image.resolution, tileSize)};
+            sourceImages.push_back({.path = image.path, .sheetSize = sheetSize, .firstTileID = tileCount + 1});
+
+            // Canonical tile IDs are local to each image, so they are offset to global tile IDs.
+            const auto [imageTileOpacities, imageCanonicalTileIDs]{loadTileAnalysis(image, tileSize)};
+            tileAnalysis.tileOpacities.insert(tileAnalysis.tileOpacities.end(), imageTileOpacities.begin(),
+                                              imageTileOpacities.end());
+            std::ranges::transform(imageCanonicalTileIDs, std::back_inserter(tileAnalysis.canonicalTileIDs),
+                                   [&](const int localTileID) { return tileCount + localTileID; });
+
+            tileCount += sheetSize.x * sheetSize.y;
+        }
+
+        std::unique_ptr textureArray{TextureArray::create(tileCount, tileResolution, channels)};
+
+        const int rowLength{tileResolution.x * channels};
+        std::vector<std::uint8_t> tileBuffer(rowLength * tileResolution.y);
+
+        int unpackAlignment{};
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Rows of RGB tiles are not necessarily 4-byte aligned.
+
+        for (std::size_t sheetIndex = 0; sheetIndex < images.size(); ++sheetIndex) {
+            const Image::Image& image{images[sheetIndex]};
+            const glm::ivec2 sheetSize{sourceImages[sheetIndex].sheetSize};
+            const int firstLayer{sourceImages[sheetIndex].firstTileID - 1};
+
+            // Tile IDs count along the rows of the image (which is flipped so that the first row is at the bottom),
+            // the same order that the texture coordinates of a single texture tile sheet are generated in.
+            for (int row = 0; row < sheetSize.y; ++row) {
+                for (int col = 0; col < sheetSize.x; ++col) {
+                    for (int tileRow = 0; tileRow < tileResolution.y; ++tileRow) {
+                        const int imageRow{row * tileResolution.y + tileRow};
+                        const int imageOffset{(imageRow * image.resolution.x + col * tileResolution.x) * channels};
+
+                        std::copy_n(image.bytes.begin() + imageOffset, rowLength,
+                                    tileBuffer.begin() + tileRow * rowLength);
+                    }
+
+                    textureArray->bufferSubImage(firstLayer + row * sheetSize.x + col, tileResolution,
+                                                 tileBuffer.data());
+                }
+            }
+        }
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment); // Restore unpack alignment.
+
+        textureArray->generateMipmaps();
+
+        return std::make_unique<TileSheet>(std::move(textureArray), tileSize, sourceImages, tileAnalysis);
+    }
+
+    TileSheet::TileSheet(std::unique_ptr<Texture> texture, const glm::vec2 tileSize, const TileAnalysis& tileAnalysis,
+                         const std::optional<glm::vec2> cellSize) :
+        m_texture(std::move(texture)),
+        m_sourceImages{{.path = m_texture->path(),
+                        .sheetSize = calculateSheetSize(m_texture->resolution(), cellSize.value_or(tileSize)),
+                        .firstTileID = 1}},
+        m_tileSize(tileSize), m_cellSize(cellSize.value_or(tileSize)), m_sheetSize(m_sourceImages.front().sheetSize),
+        m_tileCount(static_cast<int>(m_sheetSize.x * m_sheetSize.y)), m_textureCoordinateStride(1.0f / m_sheetSize),
+        m_textureCoordinateSize(m_tileSize / static_cast<glm::vec2>(m_texture->resolution())),
+        m_textureCoordinateInset(static_cast<glm::vec2>(cellInset(glm::ivec2{m_tileSize}, glm::ivec2{m_cellSize})) /
+                                 static_cast<glm::vec2>(m_texture->resolution())),
+        m_textureCoordinates(
+            generateTextureCoordinates(m_sheetSize, m_textureCoordinateStride, m_textureCoordinateInset)),
+        m_tileOpacities(tileAnalysis.tileOpacities), m_canonicalTileIDs(tileAnalysis.canonicalTileIDs) {
+        assert((m_tileOpacities.empty() or static_cast<int>(m_tileOpacities.size()) == m_tileCount) and
+               "There must be exactly one tile opacity per tile.");
+        assert((m_canonicalTileIDs.empty() or static_cast<int>(m_canonicalTileIDs.size()) == m_tileCount) and
+               "There must be exactly one canonical tile ID per tile.");
+    }
+
+    TileSheet::TileSheet(std::unique_ptr<TextureArray> textureArray, const glm::vec2 tileSize,
+                         const std::vector<SourceImage>& sourceImages, const TileAnalysis& tileAnalysis) :
+        m_textureArray(std::move(textureArray)), m_sourceImages(sourceImages), m_tileSize(tileSize),
+        m_cellSize(tileSize), m_sheetSize(m_sourceImages.front().sheetSize),
+        m_tileCount(m_sourceImages.back().firstTileID - 1 +
+                    static_cast<int>(m_sourceImages.back().sheetSize.x * m_sourceImages.back().sheetSize.y)),
+        m_textureCoordinateStride(1.0f / m_sheetSize), m_textureCoordinateSize(m_textureCoordinateStride),
+        m_textureCoordinateInset(0.0f), m_tileOpacities(tileAnalysis.tileOpacities),
+        m_canonicalTileIDs(tileAnalysis.canonicalTileIDs) {
+        assert((m_tileOpacities.empty() or static_cast<int>(m_tileOpacities.size()) == m_tileCount) and
+               "There must be exactly one tile opacity per tile.");
+        assert((m_canonicalTileIDs.empty() or static_cast<int>(m_canonicalTileIDs.size()) == m_tileCount) and
+               "There must be exactly one canonical tile ID per tile.");
     }
 
     glm::vec2 TileSheet::tileSize() const {
@@ -47,12 +485,20 @@ namespace TileEngine {
         return m_textureCoordinateStride;
     }
 
+    glm::vec2 TileSheet::textureCoordinateSize() const {
+        return m_textureCoordinateSize;
+    }
+
+    glm::vec2 TileSheet::textureCoordinateInset() const {
+        return m_textureCoordinateInset;
+    }
+
     glm::vec2 TileSheet::textureCoordinates(const int tileID) const {
         return m_textureCoordinates.at(tileID - 1);
     }
 
     int TileSheet::tileCount() const {
-        return static_cast<int>(m_sheetSize.x * m_sheetSize.y);
+        return m_tileCount;
     }
 
     glm::vec2 TileSheet::sheetSize() const {
@@ -60,10 +506,61 @@ namespace TileEngine {
     }
 
     std::string TileSheet::texturePath() const {
-        return m_texture->path();
+        return m_sourceImages.front().path;
+    }
+
+    std::vector<TileSheet::SourceImage> TileSheet::sourceImages() const {
+        return m_sourceImages;
+    }
+
+    int TileSheet::sheetCount() const {
+        return static_cast<int>(m_sourceImages.size());
+    }
+
+    TileSheet::TileSource TileSheet::tileSource(const int tileID) const {
+        assert(tileID > 0 and tileID <= m_tileCount and "Tile ID out of range.");
+
+        // Find the last source image whose first tile ID is not after the tile ID.
+        const auto sourceImage{
+            std::prev(std::ranges::upper_bound(m_sourceImages, tileID, {}, &SourceImage::firstTileID))};
+
+        return {.sheetIndex = static_cast<int>(sourceImage - m_sourceImages.begin()),
+                .localTileID = tileID - sourceImage->firstTileID + 1};
+    }
+
+    int TileSheet::tileID(const int sheetIndex, const int localTileID) const {
+        return m_sourceImages.at(sheetIndex).firstTileID + localTileID - 1;
+    }
+
+    TileSheet::TileOpacity TileSheet::tileOpacity(const int tileID) const {
+        if (tileID <= 0 or tileID > static_cast<int>(m_tileOpacities.size())) {
+            return TileOpacity::translucent;
+        }
+
+        return m_tileOpacities[tileID - 1];
+    }
+
+    int TileSheet::canonicalTileID(const int tileID) const {
+        if (tileID <= 0 or tileID > static_cast<int>(m_canonicalTileIDs.size())) {
+            return tileID;
+        }
+
+        return m_canonicalTileIDs[tileID - 1];
+    }
+
+    bool TileSheet::usesTextureArray() const {
+        return m_textureArray != nullptr;
+    }
+
+    bool TileSheet::isPadded() const {
+        return m_cellSize != m_tileSize;
     }
 
     void TileSheet::bind() const {
-        m_texture->bind();
+        if (usesTextureArray()) {
+            m_textureArray->bind();
+        } else {
+            m_texture->bind();
+        }
     }
 } // namespace TileEngine
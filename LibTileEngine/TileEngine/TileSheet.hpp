@@ -4,31 +4,156 @@
 #define LIBTILEENGINE_TILEENGINE_TILESHEET_HPP
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <glm/vec2.hpp>
 
+#include <TileEngine/Image.hpp>
 #include <TileEngine/Texture.hpp>
+#include <TileEngine/TextureArray.hpp>
 
 namespace TileEngine {
 
     /// The texture containing tiles for a tile map and info on the tiles (e.g., size, texture coordinates).
+    /// @note A tile sheet backed by a texture array may combine several images with the same tile size. Tile IDs are
+    /// then global: the tiles of the first image come first, followed by the tiles of the second image and so on.
     class TileSheet {
     public:
+        /// One of the images that the tiles of a tile sheet were loaded from.
+        struct SourceImage {
+            /// The path to the image file.
+            std::string path;
+            /// The width and height of the image in tiles.
+            glm::vec2 sheetSize;
+            /// The global tile ID of the first tile in the image.
+            int firstTileID;
+        };
+
+        /// Where a tile in a tile sheet came from.
+        struct TileSource {
+            /// The index of the source image.
+            int sheetIndex;
+            /// The ID of the tile within its source image.
+            int localTileID;
+        };
+
+        /// How much of a tile is see-through, ordered from cheapest to most expensive to draw.
+        enum class TileOpacity {
+            /// Every pixel is fully transparent, so the tile is never drawn.
+            empty,
+            /// Every pixel is fully opaque, so the tile can be drawn without blending.
+            opaque,
+            /// Every pixel is either fully opaque or fully transparent, so the tile can be drawn without blending by
+            /// discarding the transparent pixels.
+            cutout,
+            /// Some pixels are partially transparent, so the tile must be blended with whatever is behind it.
+            translucent
+        };
+
+        /// What a scan of the pixels of a tile sheet image found out about its tiles, see `analyzeTiles`.
+        struct TileAnalysis {
+            /// The opacity of each tile, in tile ID order.
+            std::vector<TileOpacity> tileOpacities;
+            /// The ID of the first tile that looks the same as each tile, in tile ID order. Tiles that look unlike
+            /// any earlier tile are their own canonical tile, and every empty tile shares the first empty tile.
+            std::vector<int> canonicalTileIDs;
+        };
+
+        /// Create a tile sheet from a single image and analyze its tiles (see `loadTileAnalysis`).
+        /// @param image An image containing a regular grid of tiles.
+        /// @param tileSize The width and height of a tile in pixels.
+        /// @return A tile sheet backed by a single texture.
+        static std::unique_ptr<TileSheet> create(const Image::Image& image, glm::vec2 tileSize);
+
+        /// Create a tile sheet from a single image whose tiles can be mipmapped without bleeding into each other.
+        /// @note The image is rebuilt into an atlas where each tile sits in the middle of a cell with power-of-two
+        /// dimensions, and the gutter around it is filled by repeating the tile's edge pixels. Mipmaps are sampled
+        /// down to the smallest level whose texels do not reach past the gutter.
+        /// @param image An image containing a regular grid of tiles.
+        /// @param tileSize The width and height of a tile in pixels.
+        /// @param minGutter The least number of pixels to pad each side of a tile with.
+        /// @return A tile sheet backed by a single, padded texture with mipmaps enabled.
+        static std::unique_ptr<TileSheet> createMipmapped(const Image::Image& image, glm::vec2 tileSize,
+                                                          int minGutter = 4);
+
+        /// Scan the alpha channel of every tile in an image.
+        /// @param image An image containing a regular grid of tiles.
+        /// @param tileSize The width and height of a tile in pixels.
+        /// @return The opacity of each tile, in tile ID order.
+        static std::vector<TileOpacity> classifyTiles(const Image::Image& image, glm::vec2 tileSize);
+
+        /// Scan the pixels of every tile in an image for empty and duplicate tiles.
+        /// @param image An image containing a regular grid of tiles.
+        /// @param tileSize The width and height of a tile in pixels.
+        /// @return The opacity and canonical tile ID of each tile. Tile IDs are local to the image.
+        static TileAnalysis analyzeTiles(const Image::Image& image, glm::vec2 tileSize);
+
+        /// Analyze the tiles of an image, reusing the analysis cached next to the image file if it is up to date.
+        /// @note The cache is written to the image path with `.tiles.yaml` appended, and is considered out of date
+        /// once the image file or the tile size changes. A cache with invalid opacities or canonical tile IDs is
+        /// replaced. Failing to write it is not an error.
+        /// @param image An image containing a regular grid of tiles.
+        /// @param tileSize The width and height of a tile in pixels.
+        /// @return The opacity and canonical tile ID of each tile. Tile IDs are local to the image.
+        static TileAnalysis loadTileAnalysis(const Image::Image& image, glm::vec2 tileSize);
+
+        /// Create a tile sheet that stores each tile in its own layer of a texture array.
+        /// @note Since tiles are sampled separately they cannot bleed into their neighbours, so the tiles can be
+        /// filtered and use full mipmap chains.
+        /// @note Throws if there are more tiles than texture array layers (see `GL_MAX_ARRAY_TEXTURE_LAYERS`).
+        /// @param image An image containing a regular grid of tiles.
+        /// @param tileSize The width and height of a tile in pixels.
+        /// @return A tile sheet where the layer index of each tile is its tile ID minus one.
+        static std::unique_ptr<TileSheet> createTextureArray(const Image::Image& image, glm::vec2 tileSize);
+
+        /// Create a tile sheet that packs the tiles of several images into one texture array, so that a tile map can
+        /// use tiles from all of them with a single texture bind.
+        /// @note Throws if there are more tiles than texture array layers (see `GL_MAX_ARRAY_TEXTURE_LAYERS`).
+        /// @param images Images containing regular grids of tiles with the same tile size and number of channels.
+        /// @param tileSize The width and height of a tile in pixels.
+        /// @return A tile sheet where the layer index of each tile is its global tile ID minus one.
+        static std::unique_ptr<TileSheet> createTextureArray(const std::vector<Image::Image>& images,
+                                                             glm::vec2 tileSize);
+
         /// Create a tile sheet.
         /// @param texture A texture containing a regular grid of tiles.
         /// @param tileSize The width and height of a tile in pixels.
-        TileSheet(std::unique_ptr<Texture> texture, glm::vec2 tileSize);
+        /// @param tileAnalysis The opacity and canonical tile ID of each tile (see `analyzeTiles`). If empty, every
+        /// tile is treated as a distinct, translucent tile.
+        /// @param cellSize The width and height in pixels of the padded cell that each tile is centred in, see
+        /// `createMipmapped`. Defaults to the tile size, i.e., no padding.
+        TileSheet(std::unique_ptr<Texture> texture, glm::vec2 tileSize, const TileAnalysis& tileAnalysis = {},
+                  std::optional<glm::vec2> cellSize = std::nullopt);
+
+        /// Create a tile sheet from a texture array with one tile per layer.
+        /// @param textureArray A texture array with a layer for each tile.
+        /// @param tileSize The width and height of a tile in pixels.
+        /// @param sourceImages The images the tiles were loaded from, in the order their tiles were added.
+        /// @param tileAnalysis The opacity and canonical global tile ID of each tile (see `analyzeTiles`). If empty,
+        /// every tile is treated as a distinct, translucent tile.
+        TileSheet(std::unique_ptr<TextureArray> textureArray, glm::vec2 tileSize,
+                  const std::vector<SourceImage>& sourceImages, const TileAnalysis& tileAnalysis = {});
 
         /// Get the dimensions of tiles in this tile sheet.
         /// @return The width and height in pixels.
         [[nodiscard]] glm::vec2 tileSize() const;
 
-        /// Get the tile size in texture coordinates.
-        /// @return Tile height and width in texture coordinates.
+        /// Get the distance between neighbouring tiles in texture coordinates.
+        /// @note This is larger than `textureCoordinateSize` if the tiles are padded.
+        /// @return The horizontal and vertical distance in texture coordinates.
         [[nodiscard]] glm::vec2 textureCoordinateStride() const;
 
+        /// Get the tile size in texture coordinates.
+        /// @return Tile width and height in texture coordinates.
+        [[nodiscard]] glm::vec2 textureCoordinateSize() const;
+
+        /// Get the offset from the corner of a tile's padded cell to the tile itself in texture coordinates.
+        /// @note This is zero if the tiles are not padded.
+        [[nodiscard]] glm::vec2 textureCoordinateInset() const;
+
         /// Get the texture coordindates for a given tile.
+        /// @note Tile sheets backed by a texture array do not have texture coordinates.
         /// @param tileID The ID of a tile. Note that the IDs correspond to the indices calculated as
         /// `1 + row * width + col` using the tile sheet dimensions.
         /// @return The texture coordinates for the given tile.
@@ -38,26 +163,83 @@ namespace TileEngine {
         [[nodiscard]] int tileCount() const;
 
         /// Get the tile sheet dimensions.
+        /// @note For tile sheets made from several images this is the size of the first image.
         /// @return The width and height measured in tiles.
         [[nodiscard]] glm::vec2 sheetSize() const;
 
         /// Get the path to the image file used to create the underlying texture.
+        /// @note For tile sheets made from several images this is the path of the first image.
         [[nodiscard]] std::string texturePath() const;
 
+        /// Get the images the tiles were loaded from.
+        [[nodiscard]] std::vector<SourceImage> sourceImages() const;
+
+        /// Get the number of images the tiles were loaded from.
+        [[nodiscard]] int sheetCount() const;
+
+        /// Find which image a tile came from.
+        /// @param tileID The global ID of a tile.
+        /// @return The index of the source image and the ID of the tile within that image.
+        [[nodiscard]] TileSource tileSource(int tileID) const;
+
+        /// Get the global ID of a tile from one of the source images.
+        /// @param sheetIndex The index of the source image.
+        /// @param localTileID The ID of the tile within the source image.
+        /// @return The global tile ID.
+        [[nodiscard]] int tileID(int sheetIndex, int localTileID) const;
+
+        /// Get how much of a tile is see-through.
+        /// @param tileID The global ID of a tile.
+        /// @return The opacity of the tile, or `TileOpacity::translucent` if it is unknown.
+        [[nodiscard]] TileOpacity tileOpacity(int tileID) const;
+
+        /// Get the tile that looks the same as a tile and should be used in its place.
+        /// @note Tiles are only compared with tiles from the same source image.
+        /// @param tileID The global ID of a tile.
+        /// @return The global ID of the canonical tile, which is the tile ID itself if no earlier tile looks the same
+        /// or the tiles were not analyzed.
+        [[nodiscard]] int canonicalTileID(int tileID) const;
+
+        /// Whether the tiles are stored in a texture array with one layer per tile instead of a single texture.
+        [[nodiscard]] bool usesTextureArray() const;
+
+        /// Whether each tile is centred in a larger cell so that it can be mipmapped, see `createMipmapped`.
+        [[nodiscard]] bool isPadded() const;
+
         /// Bind the tile sheet texture for rendering.
         void bind() const;
 
     private:
         /// The texture containing a regular grid of tiles.
+        /// @note Null if the tile sheet is backed by a texture array.
         const std::unique_ptr<Texture> m_texture;
+        /// The texture array containing one tile per layer.
+        /// @note Null if the tile sheet is backed by a single texture.
+        const std::unique_ptr<TextureArray> m_textureArray;
+        /// The images the tiles were loaded from, sorted by their first tile ID.
+        const std::vector<SourceImage> m_sourceImages;
         /// The width and height of a tile in pixels.
         const glm::vec2 m_tileSize;
+        /// The width and height of the padded cell each tile is centred in, in pixels.
+        const glm::vec2 m_cellSize;
         /// The width and height of the tile sheet in tiles.
         const glm::vec2 m_sheetSize;
-        /// The tile size in texture coordinates.
+        /// The number of tiles across all source images.
+        const int m_tileCount;
+        /// The distance between neighbouring tiles in texture coordinates.
         const glm::vec2 m_textureCoordinateStride;
+        /// The tile size in texture coordinates.
+        const glm::vec2 m_textureCoordinateSize;
+        /// The offset from the corner of a padded cell to its tile in texture coordinates.
+        const glm::vec2 m_textureCoordinateInset;
         /// The UV corners for each tile.
         const std::vector<glm::vec2> m_textureCoordinates;
+        /// The opacity of each tile in tile ID order.
+        /// @note Empty if the tiles were not classified.
+        const std::vector<TileOpacity> m_tileOpacities;
+        /// The canonical tile ID of each tile in tile ID order.
+        /// @note Empty if the tiles were not analyzed.
+        const std::vector<int> m_canonicalTileIDs;
     };
 
 } // namespace TileEngine
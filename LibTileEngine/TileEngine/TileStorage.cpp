@@ -0,0 +1,43 @@
+#include <functional>
+
+#include <TileEngine/TileStorage.hpp>
+
+namespace TileEngine {
+    namespace {
+        /// Divide and round towards negative infinity so that negative grid coordinates map to the correct chunk.
+        std::int64_t floorDivide(const std::int64_t value, const std::int64_t divisor) {
+            return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+        }
+    } // namespace
+
+    std::size_t ChunkCoordinatesHash::operator()(const glm::i64vec2& chunkCoordinates) const noexcept {
+        const std::size_t xHash{std::hash<std::int64_t>{}(chunkCoordinates.x)};
+        const std::size_t yHash{std::hash<std::int64_t>{}(chunkCoordinates.y)};
+
+        // Boost's `hash_combine`.
+        return xHash ^ (yHash + 0x9e3779b97f4a7c15 + (xHash << 6) + (xHash >> 2));
+    }
+
+    ChunkCacheStats& ChunkCacheStats::operator+=(const ChunkCacheStats& other) {
+        hits += other.hits;
+        misses += other.misses;
+        decompressionTime += other.decompressionTime;
+        compressions += other.compressions;
+        residentBytes += other.residentBytes;
+        compressedBytes += other.compressedBytes;
+
+        return *this;
+    }
+
+    glm::i64vec2 ChunkGrid::toChunkCoordinates(const glm::i64vec2 gridCoordinates) {
+        return {floorDivide(gridCoordinates.x, chunkSize), floorDivide(gridCoordinates.y, chunkSize)};
+    }
+
+    glm::i64vec2 ChunkGrid::toChunkGroupCoordinates(const glm::i64vec2 chunkCoordinates) {
+        return {floorDivide(chunkCoordinates.x, chunkGroupSize), floorDivide(chunkCoordinates.y, chunkGroupSize)};
+    }
+
+    glm::ivec2 ChunkGrid::toLocalCoordinates(const glm::i64vec2 gridCoordinates) {
+        return glm::ivec2{gridCoordinates - toChunkCoordinates(gridCoordinates) * static_cast<std::int64_t>(chunkSize)};
+    }
+} // namespace TileEngine
@@ -0,0 +1,980 @@
+#ifndef LIBTILEENGINE_TILEENGINE_TILESTORAGE_HPP
+#define LIBTILEENGINE_TILEENGINE_TILESTORAGE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <glm/ext/vector_int2_sized.hpp>
+#include <glm/vec2.hpp>
+
+#include <TileEngine/PackedTiles.hpp>
+
+namespace TileEngine {
+    /// Hashes chunk coordinates so they can be used as keys in unordered containers.
+    struct ChunkCoordinatesHash {
+        std::size_t operator()(const glm::i64vec2& chunkCoordinates) const noexcept;
+    };
+
+    /// The layout of the fixed-size square chunks that tiles are grouped into.
+    struct ChunkGrid {
+        /// The width and height of a chunk in tiles.
+        static constexpr int chunkSize{32};
+
+        /// A bitmask of the occupied tiles in one row of a chunk, where bit `i` is set if the tile in column `i` is not
+        /// empty.
+        using RowMask = std::uint32_t;
+        static_assert(chunkSize <= std::numeric_limits<RowMask>::digits, "A chunk row must fit in a row mask.");
+
+        /// Get the coordinates of the chunk that contains a tile.
+        /// @param gridCoordinates The coordinates (column, row) of the tile.
+        /// @return The coordinates (column, row) of the chunk in the chunk grid.
+        [[nodiscard]] static glm::i64vec2 toChunkCoordinates(glm::i64vec2 gridCoordinates);
+
+        /// The width and height of a chunk group in chunks.
+        static constexpr int chunkGroupSize{4};
+
+        /// Get the coordinates of the group of chunks that contains a chunk.
+        /// @param chunkCoordinates The coordinates (column, row) of the chunk in the chunk grid.
+        /// @return The coordinates (column, row) of the chunk group.
+        [[nodiscard]] static glm::i64vec2 toChunkGroupCoordinates(glm::i64vec2 chunkCoordinates);
+
+        /// Get the coordinates of a tile relative to the bottom left corner of its chunk.
+        /// @param gridCoordinates The coordinates (column, row) of the tile.
+        /// @return The coordinates (column, row) of the tile within its chunk.
+        [[nodiscard]] static glm::ivec2 toLocalCoordinates(glm::i64vec2 gridCoordinates);
+    };
+
+    /// A compressed chunk of tiles, see `TileStorage::compressColdChunks`.
+    /// @note Packed chunks are not tied to a tile ID type, so they can be shared between storage of different types.
+    struct PackedChunk {
+        /// The tile IDs in row-major order.
+        PackedTiles tiles;
+        /// The occupied tiles of each row, see `ChunkGrid::RowMask`.
+        std::array<ChunkGrid::RowMask, ChunkGrid::chunkSize> occupancy;
+        /// The number of non-empty tiles in the chunk.
+        int tileCount;
+    };
+
+    /// Counters for how often chunks had to be decompressed, see `TileStorage::compressColdChunks`.
+    struct ChunkCacheStats {
+        /// The number of chunk accesses that found the chunk uncompressed.
+        std::uint64_t hits{0};
+        /// The number of chunk accesses that had to decompress the chunk first.
+        std::uint64_t misses{0};
+        /// The total time spent decompressing chunks.
+        std::chrono::nanoseconds decompressionTime{0};
+        /// The number of chunks that have been compressed.
+        std::uint64_t compressions{0};
+        /// The memory taken up by uncompressed chunks in bytes.
+        std::size_t residentBytes{0};
+        /// The memory taken up by compressed chunks in bytes.
+        std::size_t compressedBytes{0};
+
+        /// Add the counters of another layer.
+        ChunkCacheStats& operator+=(const ChunkCacheStats& other);
+    };
+
+    /// How many tiles use each tile ID in the part of a region that lies within one chunk, see
+    /// `TileStorage::tileCounts`.
+    struct ChunkTileCounts {
+        /// The coordinates (column, row) of the chunk.
+        glm::i64vec2 chunkCoordinates;
+        /// Pairs of non-empty tile IDs and the number of tiles that use them, sorted by tile ID.
+        std::vector<std::pair<int, int>> tileCounts;
+    };
+
+    /// Sparse storage for the tile IDs of a single tile layer.
+    /// Tiles are grouped into chunks (see `ChunkGrid`) that are kept in a hash map keyed by chunk coordinates, so only
+    /// chunks that contain at least one tile take up memory and grid coordinates may be negative.
+    /// @note Copies share their chunks until one of them changes a chunk, at which point only that chunk is copied. A
+    /// copy is therefore as cheap as copying the chunk pointers, and a copy that is no longer changed can be read from
+    /// other threads while the original is being edited.
+    /// @note Chunks with identical tiles can also share memory within one storage, see `deduplicate`.
+    /// @note Chunks that have not been used for a while can be compressed to stay within a memory budget, see
+    /// `compressColdChunks`. Compressed chunks can still be read, and are decompressed when they are next changed or
+    /// viewed with `chunkTiles`.
+    /// @tparam TileID The unsigned integer type tile IDs are stored as. Narrower types use less memory and cache
+    /// bandwidth, but limit the largest tile ID that can be stored.
+    template <typename TileID>
+    class TileStorage {
+    public:
+        /// The largest tile ID that can be stored.
+        static constexpr int maxTileID{std::numeric_limits<TileID>::max()};
+
+        /// The tiles of one chunk.
+        struct Chunk {
+            /// The tile IDs in row-major order.
+            std::array<TileID, ChunkGrid::chunkSize * ChunkGrid::chunkSize> tiles{};
+            /// The occupied tiles of each row, see `ChunkGrid::RowMask`.
+            std::array<ChunkGrid::RowMask, ChunkGrid::chunkSize> occupancy{};
+            /// The number of non-empty tiles in the chunk.
+            int tileCount{0};
+
+            /// Set a tile ID and keep the occupancy and tile count up to date.
+            /// @param localCoordinates The coordinates (column, row) of the tile within the chunk.
+            /// @param tileID The new tile ID, where zero indicates an empty tile.
+            void setTileID(const glm::ivec2 localCoordinates, const TileID tileID) {
+                const ChunkGrid::RowMask bit{ChunkGrid::RowMask{1} << localCoordinates.x};
+                ChunkGrid::RowMask& rowMask{occupancy[localCoordinates.y]};
+
+                tileCount += (tileID != 0) - ((rowMask & bit) != 0);
+                tiles[localCoordinates.y * ChunkGrid::chunkSize + localCoordinates.x] = tileID;
+                rowMask = tileID != 0 ? rowMask | bit : rowMask & ~bit;
+            }
+
+            /// Hash the tile IDs of the chunk.
+            [[nodiscard]] std::size_t hash() const {
+                const std::string_view bytes{reinterpret_cast<const char*>(tiles.data()), sizeof(tiles)};
+
+                return std::hash<std::string_view>{}(bytes);
+            }
+        };
+
+        TileStorage() = default;
+
+        /// Copy the tiles from storage with a different tile ID type.
+        /// @note Chunks that are shared in the other storage are also shared in the copy, and compressed chunks stay
+        /// compressed.
+        /// @param other The storage to copy. Every tile ID in it must be at most `maxTileID`.
+        template <typename OtherTileID>
+        explicit TileStorage(const TileStorage<OtherTileID>& other) {
+            std::unordered_map<const void*, std::shared_ptr<Chunk>> convertedChunks{};
+
+            for (const auto& [chunkCoordinates, otherEntry] : other.m_chunks) {
+                if (otherEntry.packed != nullptr) {
+                    assert(otherEntry.packed->tiles.largestTileID() <= maxTileID and
+                           "Tile ID too large for the new tile ID type.");
+                    m_chunks.emplace(chunkCoordinates, ChunkEntry{nullptr, otherEntry.packed, otherEntry.lastAccess});
+                    continue;
+                }
+
+                const auto& otherChunk{otherEntry.chunk};
+                std::shared_ptr<Chunk>& tileChunk{convertedChunks[otherChunk.get()]};
+
+                if (tileChunk == nullptr) {
+                    tileChunk = std::make_shared<Chunk>();
+
+                    for (std::size_t i = 0; i < otherChunk->tiles.size(); ++i) {
+                        assert(otherChunk->tiles[i] <= maxTileID and "Tile ID too large for the new tile ID type.");
+                        tileChunk->tiles[i] = static_cast<TileID>(otherChunk->tiles[i]);
+                    }
+
+                    tileChunk->occupancy = otherChunk->occupancy;
+                    tileChunk->tileCount = otherChunk->tileCount;
+                }
+
+                m_chunks.emplace(chunkCoordinates, ChunkEntry{tileChunk, nullptr, otherEntry.lastAccess});
+            }
+
+            m_accessClock = other.m_accessClock;
+        }
+
+        /// Get a tile ID.
+        /// @note Compressed chunks are read without decompressing them.
+        /// @param gridCoordinates The coordinates (column, row) of the tile.
+        /// @return The tile ID, or zero if the tile is empty.
+        [[nodiscard]] int tileID(const glm::i64vec2 gridCoordinates) const {
+            const auto chunkIterator{m_chunks.find(ChunkGrid::toChunkCoordinates(gridCoordinates))};
+
+            if (chunkIterator == m_chunks.end()) {
+                return 0;
+            }
+
+            const glm::ivec2 localCoordinates{ChunkGrid::toLocalCoordinates(gridCoordinates)};
+            const std::size_t index{static_cast<std::size_t>(localCoordinates.y * ChunkGrid::chunkSize) +
+                                    localCoordinates.x};
+            const ChunkEntry& entry{chunkIterator->second};
+
+            return entry.chunk != nullptr ? entry.chunk->tiles[index] : entry.packed->tiles.tileID(index);
+        }
+
+        /// Set a tile ID.
+        /// @note A chunk is created the first time one of its tiles is set and removed once all of its tiles are empty.
+        /// @param gridCoordinates The coordinates (column, row) of the tile.
+        /// @param tileID The new tile ID, where zero indicates an empty tile.
+        void setTileID(const glm::i64vec2 gridCoordinates, const int tileID) {
+            assert(tileID >= 0 and tileID <= maxTileID and "Tile ID out of range for the tile ID type.");
+
+            const glm::i64vec2 chunkCoordinates{ChunkGrid::toChunkCoordinates(gridCoordinates)};
+            auto chunkIterator{m_chunks.find(chunkCoordinates)};
+
+            if (chunkIterator == m_chunks.end()) {
+                // Clearing a tile in an empty chunk should not allocate it.
+                if (tileID == 0) {
+                    return;
+                }
+
+                chunkIterator = m_chunks.emplace(chunkCoordinates, ChunkEntry{std::make_shared<Chunk>()}).first;
+            }
+
+            Chunk& tileChunk{mutableChunk(unpackedChunk(chunkIterator->second))};
+            tileChunk.setTileID(ChunkGrid::toLocalCoordinates(gridCoordinates), static_cast<TileID>(tileID));
+
+            if (tileChunk.tileCount == 0) {
+                m_chunks.erase(chunkIterator);
+            }
+        }
+
+        /// Get the tiles of a rectangular region.
+        /// @note Compressed chunks are read without decompressing them.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param size The size (width, height) of the region in tiles.
+        /// @return The tile IDs of the region in row-major order.
+        [[nodiscard]] std::vector<int> tiles(const glm::i64vec2 start, const glm::ivec2 size) const {
+            std::vector<int> regionTiles(static_cast<std::size_t>(size.x) * size.y);
+
+            // Copy whole chunk rows at a time rather than looking up the chunk for every tile.
+            for (int row = 0; row < size.y; ++row) {
+                int col{0};
+
+                while (col < size.x) {
+                    const glm::i64vec2 gridCoordinates{start.x + col, start.y + row};
+                    const glm::ivec2 localCoordinates{ChunkGrid::toLocalCoordinates(gridCoordinates)};
+                    const int spanLength{std::min(ChunkGrid::chunkSize - localCoordinates.x, size.x - col)};
+                    const auto output{regionTiles.begin() + row * size.x + col};
+
+                    if (const auto chunkIterator{m_chunks.find(ChunkGrid::toChunkCoordinates(gridCoordinates))};
+                        chunkIterator != m_chunks.end()) {
+                        const ChunkEntry& entry{chunkIterator->second};
+                        const int chunkRowStart{localCoordinates.y * ChunkGrid::chunkSize + localCoordinates.x};
+
+                        if (entry.chunk != nullptr) {
+                            std::copy_n(entry.chunk->tiles.begin() + chunkRowStart, spanLength, output);
+                        } else {
+                            for (int i = 0; i < spanLength; ++i) {
+                                output[i] = entry.packed->tiles.tileID(chunkRowStart + i);
+                            }
+                        }
+                    }
+
+                    col += spanLength;
+                }
+            }
+
+            return regionTiles;
+        }
+
+        /// Set the tiles of a rectangular region.
+        /// @note Tiles are copied a chunk row at a time, and empty parts of the region do not allocate chunks.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param size The size (width, height) of the region in tiles.
+        /// @param tiles The tile IDs of the region in row-major order.
+        /// @return The coordinates of the chunks that were changed.
+        std::vector<glm::i64vec2> setTiles(const glm::i64vec2 start, const glm::ivec2 size,
+                                           const std::vector<int>& tiles) {
+            assert(static_cast<int>(tiles.size()) == size.x * size.y and "There must be exactly one tile ID per tile.");
+            assert(std::ranges::all_of(tiles, [](const int tileID) { return tileID >= 0 and tileID <= maxTileID; }) and
+                   "Tile ID out of range for the tile ID type.");
+
+            return modifyChunks(start, start + glm::i64vec2{size}, true, [&](ChunkEntry& entry, const ChunkSpan span) {
+                const auto sourceRow{[&](const int row) {
+                    const glm::i64vec2 regionCoordinates{span.chunkStart - start +
+                                                         glm::i64vec2{span.localStart.x, row}};
+                    return tiles.begin() + regionCoordinates.y * size.x + regionCoordinates.x;
+                }};
+
+                // Don't allocate a chunk just to fill it with empty tiles.
+                if (entry.chunk != nullptr and entry.chunk->tileCount == 0 and
+                    std::ranges::all_of(span.rows(), [&](const int row) {
+                        return std::all_of(sourceRow(row), sourceRow(row) + span.width(),
+                                           [](const int tileID) { return tileID == 0; });
+                    })) {
+                    return false;
+                }
+
+                Chunk& tileChunk{mutableChunk(unpackedChunk(entry))};
+
+                for (const int row : span.rows()) {
+                    std::transform(sourceRow(row), sourceRow(row) + span.width(), span.rowBegin(tileChunk, row),
+                                   [](const int tileID) { return static_cast<TileID>(tileID); });
+                    updateOccupancy(tileChunk, row, span);
+                }
+
+                return true;
+            });
+        }
+
+        /// Set every tile in a rectangular region to the same tile ID.
+        /// @note Each chunk row is filled in one go.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param end The coordinates (column, row) one past the top right tile of the region.
+        /// @param tileID The new tile ID, where zero indicates an empty tile.
+        /// @return The coordinates of the chunks that were changed.
+        std::vector<glm::i64vec2> fill(const glm::i64vec2 start, const glm::i64vec2 end, const int tileID) {
+            assert(tileID >= 0 and tileID <= maxTileID and "Tile ID out of range for the tile ID type.");
+
+            if (tileID == 0) {
+                return clear(start, end);
+            }
+
+            return modifyChunks(start, end, true, [&](ChunkEntry& entry, const ChunkSpan span) {
+                Chunk& tileChunk{mutableChunk(unpackedChunk(entry))};
+                const ChunkGrid::RowMask spanMask{rowMask(span.localStart.x, span.localEnd.x)};
+
+                for (const int row : span.rows()) {
+                    std::fill_n(span.rowBegin(tileChunk, row), span.width(), static_cast<TileID>(tileID));
+                    tileChunk.tileCount += std::popcount(static_cast<ChunkGrid::RowMask>(spanMask &
+                                                                                         ~tileChunk.occupancy[row]));
+                    tileChunk.occupancy[row] |= spanMask;
+                }
+
+                return true;
+            });
+        }
+
+        /// Replace every occurrence of one tile ID with another within a rectangular region.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param end The coordinates (column, row) one past the top right tile of the region.
+        /// @param fromTileID The tile ID to replace. Zero replaces the empty tiles.
+        /// @param toTileID The tile ID to replace it with. Zero empties the tiles.
+        /// @param replacedCounts If not null, the number of tiles replaced in each changed chunk is appended to it, in
+        /// the same order as the returned chunks.
+        /// @return The coordinates of the chunks that were changed.
+        std::vector<glm::i64vec2> replace(const glm::i64vec2 start, const glm::i64vec2 end, const int fromTileID,
+                                          const int toTileID, std::vector<int>* replacedCounts = nullptr) {
+            assert(toTileID >= 0 and toTileID <= maxTileID and "Tile ID out of range for the tile ID type.");
+
+            if (fromTileID == toTileID or fromTileID < 0 or fromTileID > maxTileID) {
+                return {};
+            }
+
+            const auto from{static_cast<TileID>(fromTileID)};
+            const auto to{static_cast<TileID>(toTileID)};
+
+            // Empty tiles live in chunks that are not stored, so those chunks have to be created to be filled in.
+            return modifyChunks(start, end, fromTileID == 0, [&](ChunkEntry& entry, const ChunkSpan span) {
+                // Look before copying or decompressing a chunk that may not contain the tile at all.
+                if (!spanContains(entry, span, fromTileID)) {
+                    return false;
+                }
+
+                Chunk& tileChunk{mutableChunk(unpackedChunk(entry))};
+                int replacedTiles{0};
+
+                for (const int row : span.rows()) {
+                    std::for_each(span.rowBegin(tileChunk, row), span.rowBegin(tileChunk, row) + span.width(),
+                                  [&](TileID& tileID) {
+                                      if (tileID == from) {
+                                          tileID = to;
+                                          ++replacedTiles;
+                                      }
+                                  });
+                    updateOccupancy(tileChunk, row, span);
+                }
+
+                if (replacedCounts != nullptr) {
+                    replacedCounts->push_back(replacedTiles);
+                }
+
+                return true;
+            });
+        }
+
+        /// Count the tiles with a tile ID within a rectangular region.
+        /// @note Compressed chunks are read without decompressing them.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param end The coordinates (column, row) one past the top right tile of the region.
+        /// @param tileID The tile ID to count. Zero counts the empty tiles.
+        /// @return The number of tiles with the tile ID.
+        [[nodiscard]] std::int64_t count(const glm::i64vec2 start, const glm::i64vec2 end, const int tileID) const {
+            // Tile IDs that do not fit the tile ID type are never stored.
+            if (start.x >= end.x or start.y >= end.y or tileID < 0 or tileID > maxTileID) {
+                return 0;
+            }
+
+            std::int64_t tileCount{0};
+
+            forEachChunk(start, end, [&](const ChunkEntry& entry, const ChunkSpan span) {
+                // Empty tiles are counted from the occupancy masks, as the tiles that are not occupied.
+                if (tileID == 0) {
+                    const std::span occupancy{entryOccupancy(entry)};
+                    const ChunkGrid::RowMask spanMask{rowMask(span.localStart.x, span.localEnd.x)};
+
+                    for (const int row : span.rows()) {
+                        tileCount -= std::popcount(static_cast<ChunkGrid::RowMask>(occupancy[row] & spanMask));
+                    }
+
+                    return;
+                }
+
+                for (const int row : span.rows()) {
+                    if (entry.chunk != nullptr) {
+                        const auto rowBegin{span.rowBegin(std::as_const(*entry.chunk), row)};
+                        tileCount += std::count(rowBegin, rowBegin + span.width(), static_cast<TileID>(tileID));
+                    } else {
+                        const int rowStart{row * ChunkGrid::chunkSize + span.localStart.x};
+
+                        for (int i = rowStart; i < rowStart + span.width(); ++i) {
+                            tileCount += entry.packed->tiles.tileID(i) == tileID;
+                        }
+                    }
+                }
+            });
+
+            if (tileID == 0) {
+                tileCount += (end.x - start.x) * (end.y - start.y);
+            }
+
+            return tileCount;
+        }
+
+        /// Count how many tiles use each tile ID in a rectangular region, chunk by chunk.
+        /// @note Compressed chunks are read without decompressing them. Only the tiles within the region are read.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param end The coordinates (column, row) one past the top right tile of the region.
+        /// @return The tile counts of each stored chunk that overlaps the region.
+        [[nodiscard]] std::vector<ChunkTileCounts> tileCounts(const glm::i64vec2 start, const glm::i64vec2 end) const {
+            std::vector<ChunkTileCounts> chunkTileCounts{};
+            std::vector<TileID> spanTiles{};
+
+            if (start.x >= end.x or start.y >= end.y) {
+                return chunkTileCounts;
+            }
+
+            forEachChunk(start, end, [&](const ChunkEntry& entry, const ChunkSpan span) {
+                spanTiles.clear();
+
+                for (const int row : span.rows()) {
+                    if (entry.chunk != nullptr) {
+                        const auto rowBegin{span.rowBegin(std::as_const(*entry.chunk), row)};
+                        std::copy_if(rowBegin, rowBegin + span.width(), std::back_inserter(spanTiles),
+                                     [](const TileID tileID) { return tileID != 0; });
+                    } else {
+                        const int rowStart{row * ChunkGrid::chunkSize + span.localStart.x};
+
+                        for (int i = rowStart; i < rowStart + span.width(); ++i) {
+                            if (const int tileID{entry.packed->tiles.tileID(i)}; tileID != 0) {
+                                spanTiles.push_back(static_cast<TileID>(tileID));
+                            }
+                        }
+                    }
+                }
+
+                // Sorting groups equal tile IDs together, so each tile ID is counted as one run.
+                std::ranges::sort(spanTiles);
+                ChunkTileCounts& counts{chunkTileCounts.emplace_back(
+                    ChunkGrid::toChunkCoordinates(span.chunkStart), std::vector<std::pair<int, int>>{})};
+
+                for (auto run{spanTiles.begin()}; run != spanTiles.end();) {
+                    const auto runEnd{std::ranges::upper_bound(run, spanTiles.end(), *run)};
+                    counts.tileCounts.emplace_back(*run, static_cast<int>(runEnd - run));
+                    run = runEnd;
+                }
+            });
+
+            return chunkTileCounts;
+        }
+
+        /// Set every tile in a rectangular region to empty.
+        /// @note Only the chunks that overlap the region are visited, so clearing a large, mostly empty region is
+        /// cheap.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param end The coordinates (column, row) one past the top right tile of the region.
+        /// @return The coordinates of the chunks that were changed.
+        std::vector<glm::i64vec2> clear(const glm::i64vec2 start, const glm::i64vec2 end) {
+            return modifyChunks(start, end, false, [&](ChunkEntry& entry, const ChunkSpan span) {
+                const ChunkGrid::RowMask regionMask{rowMask(span.localStart.x, span.localEnd.x)};
+
+                // Chunks without tiles in the region are left shared with any copies, and compressed.
+                const std::span occupancy{entryOccupancy(entry)};
+
+                if (std::none_of(occupancy.begin() + span.localStart.y, occupancy.begin() + span.localEnd.y,
+                                 [&](const ChunkGrid::RowMask mask) { return (mask & regionMask) != 0; })) {
+                    return false;
+                }
+
+                Chunk& tileChunk{mutableChunk(unpackedChunk(entry))};
+
+                // Only the occupied tiles within the region are visited.
+                for (const int row : span.rows()) {
+                    ChunkGrid::RowMask clearedTiles{tileChunk.occupancy[row] & regionMask};
+
+                    if (clearedTiles == 0) {
+                        continue;
+                    }
+
+                    tileChunk.occupancy[row] &= ~clearedTiles;
+                    tileChunk.tileCount -= std::popcount(clearedTiles);
+
+                    for (; clearedTiles != 0; clearedTiles &= clearedTiles - 1) {
+                        tileChunk.tiles[row * ChunkGrid::chunkSize + std::countr_zero(clearedTiles)] = 0;
+                    }
+                }
+
+                return true;
+            });
+        }
+
+        /// Decompress a chunk if it is compressed and mark it as recently used.
+        /// @note Call this before `chunkTiles` for chunks that may have been compressed.
+        /// @param chunkCoordinates The coordinates (column, row) of the chunk.
+        void touchChunk(const glm::i64vec2 chunkCoordinates) {
+            if (const auto chunkIterator{m_chunks.find(chunkCoordinates)}; chunkIterator != m_chunks.end()) {
+                unpackedChunk(chunkIterator->second);
+            }
+        }
+
+        /// Get a read-only view of the tiles of a chunk without copying them.
+        /// @param chunkCoordinates The coordinates (column, row) of the chunk. The chunk must not be compressed, see
+        /// `touchChunk`.
+        /// @return The tile IDs of the chunk in row-major order, or an empty view if all of the chunk's tiles are
+        /// empty. The view is invalidated by any change to the storage.
+        [[nodiscard]] std::span<const TileID> chunkTiles(const glm::i64vec2 chunkCoordinates) const {
+            const auto chunkIterator{m_chunks.find(chunkCoordinates)};
+
+            if (chunkIterator == m_chunks.end()) {
+                return {};
+            }
+
+            assert(chunkIterator->second.chunk != nullptr and "Compressed chunks must be touched before viewing them.");
+
+            return chunkIterator->second.chunk->tiles;
+        }
+
+        /// Get the occupied tiles of a chunk.
+        /// @param chunkCoordinates The coordinates (column, row) of the chunk.
+        /// @return One `ChunkGrid::RowMask` per row of the chunk, or an empty view if all of the chunk's tiles are
+        /// empty. The view is invalidated by any change to the storage.
+        [[nodiscard]] std::span<const ChunkGrid::RowMask> chunkOccupancy(const glm::i64vec2 chunkCoordinates) const {
+            const auto chunkIterator{m_chunks.find(chunkCoordinates)};
+
+            if (chunkIterator == m_chunks.end()) {
+                return {};
+            }
+
+            return entryOccupancy(chunkIterator->second);
+        }
+
+        /// Get the number of non-empty tiles in a chunk.
+        /// @param chunkCoordinates The coordinates (column, row) of the chunk.
+        [[nodiscard]] int chunkTileCount(const glm::i64vec2 chunkCoordinates) const {
+            const auto chunkIterator{m_chunks.find(chunkCoordinates)};
+
+            if (chunkIterator == m_chunks.end()) {
+                return 0;
+            }
+
+            const ChunkEntry& entry{chunkIterator->second};
+
+            return entry.chunk != nullptr ? entry.chunk->tileCount : entry.packed->tileCount;
+        }
+
+        /// Get the coordinates of every chunk that contains at least one tile.
+        [[nodiscard]] std::vector<glm::i64vec2> chunkCoordinates() const {
+            std::vector<glm::i64vec2> coordinates{};
+            coordinates.reserve(m_chunks.size());
+
+            for (const auto& [chunkKey, _] : m_chunks) {
+                coordinates.push_back(chunkKey);
+            }
+
+            return coordinates;
+        }
+
+        /// Get the coordinates of the chunks that overlap a rectangular region.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param end The coordinates (column, row) one past the top right tile of the region.
+        /// @param storedOnly Whether to leave out the chunks that are not stored, i.e., the empty chunks.
+        [[nodiscard]] std::vector<glm::i64vec2> chunksInRegion(const glm::i64vec2 start, const glm::i64vec2 end,
+                                                               const bool storedOnly) const {
+            const glm::i64vec2 firstChunk{ChunkGrid::toChunkCoordinates(start)};
+            const glm::i64vec2 lastChunk{ChunkGrid::toChunkCoordinates(end - std::int64_t{1})};
+            const glm::i64vec2 chunksAcross{lastChunk - firstChunk + std::int64_t{1}};
+            std::vector<glm::i64vec2> chunks{};
+
+            if (start.x >= end.x or start.y >= end.y) {
+                return chunks;
+            }
+
+            // A sparse map may have far fewer chunks than a large region covers.
+            if (storedOnly and static_cast<std::uint64_t>(chunksAcross.x * chunksAcross.y) > m_chunks.size()) {
+                for (const glm::i64vec2 chunkCoordinates : m_chunks | std::views::keys) {
+                    if (glm::all(glm::greaterThanEqual(chunkCoordinates, firstChunk)) and
+                        glm::all(glm::lessThanEqual(chunkCoordinates, lastChunk))) {
+                        chunks.push_back(chunkCoordinates);
+                    }
+                }
+
+                return chunks;
+            }
+
+            for (std::int64_t chunkRow = firstChunk.y; chunkRow <= lastChunk.y; ++chunkRow) {
+                for (std::int64_t chunkCol = firstChunk.x; chunkCol <= lastChunk.x; ++chunkCol) {
+                    if (!storedOnly or m_chunks.contains({chunkCol, chunkRow})) {
+                        chunks.emplace_back(chunkCol, chunkRow);
+                    }
+                }
+            }
+
+            return chunks;
+        }
+
+        /// Get the number of chunks that contain at least one tile.
+        [[nodiscard]] std::size_t chunkCount() const {
+            return m_chunks.size();
+        }
+
+        /// Get the number of chunks that take up memory, where chunks shared between several chunk coordinates are
+        /// counted once.
+        [[nodiscard]] std::size_t uniqueChunkCount() const {
+            std::unordered_set<const void*> uniqueChunks{};
+
+            for (const auto& [tileChunk, packed, lastAccess] : m_chunks | std::views::values) {
+                uniqueChunks.insert(tileChunk != nullptr ? static_cast<const void*>(tileChunk.get()) : packed.get());
+            }
+
+            return uniqueChunks.size();
+        }
+
+        /// Make chunks with identical tiles share one block of memory.
+        /// @note Shared chunks are copied the first time one of their tiles is changed, so sharing does not affect
+        /// the tiles that are read back. Chunks are only compared when this is called, e.g., after loading or
+        /// generating a map, since hashing chunks on every change would slow down editing. Compressed chunks are left
+        /// as they are.
+        /// @return The number of chunks that now share another chunk's memory.
+        std::size_t deduplicate() {
+            std::unordered_map<std::size_t, std::vector<std::shared_ptr<Chunk>>> chunksByHash{};
+            std::size_t sharedChunkCount{0};
+
+            for (auto& tileChunk : m_chunks | std::views::values | std::views::transform(&ChunkEntry::chunk)) {
+                if (tileChunk == nullptr) {
+                    continue;
+                }
+
+                auto& candidates{chunksByHash[tileChunk->hash()]};
+                const auto match{std::ranges::find_if(candidates, [&](const std::shared_ptr<Chunk>& candidate) {
+                    return candidate == tileChunk or candidate->tiles == tileChunk->tiles;
+                })};
+
+                if (match == candidates.end()) {
+                    candidates.push_back(tileChunk);
+                } else if (*match != tileChunk) {
+                    tileChunk = *match;
+                    ++sharedChunkCount;
+                }
+            }
+
+            return sharedChunkCount;
+        }
+
+        /// Compress the least recently used chunks until the chunks fit in a memory budget.
+        /// @note Chunks are used when they are changed or touched (see `touchChunk`). Chunks shared by several chunk
+        /// coordinates are compressed together, once none of them has been used more recently than the others.
+        /// @param memoryBudget The most memory the chunks of this storage should take up in bytes.
+        /// @return The number of chunks that were compressed.
+        std::size_t compressColdChunks(const std::size_t memoryBudget) {
+            const ChunkCacheStats usage{cacheStats()};
+            std::size_t memoryUsed{usage.residentBytes + usage.compressedBytes};
+
+            if (memoryUsed <= memoryBudget) {
+                return 0;
+            }
+
+            /// The coordinates that share an uncompressed chunk.
+            struct SharedChunk {
+                std::uint64_t lastAccess{0};
+                std::vector<ChunkEntry*> entries{};
+            };
+
+            std::unordered_map<const Chunk*, SharedChunk> residentChunks{};
+
+            for (ChunkEntry& entry : m_chunks | std::views::values) {
+                if (entry.chunk != nullptr) {
+                    SharedChunk& shared{residentChunks[entry.chunk.get()]};
+                    shared.lastAccess = std::max(shared.lastAccess, entry.lastAccess);
+                    shared.entries.push_back(&entry);
+                }
+            }
+
+            std::vector<SharedChunk*> coldestFirst{};
+            coldestFirst.reserve(residentChunks.size());
+
+            for (SharedChunk& shared : residentChunks | std::views::values) {
+                coldestFirst.push_back(&shared);
+            }
+
+            std::ranges::sort(coldestFirst, {}, &SharedChunk::lastAccess);
+            std::size_t compressedCount{0};
+
+            for (const SharedChunk* shared : coldestFirst) {
+                if (memoryUsed <= memoryBudget) {
+                    break;
+                }
+
+                const auto packed{pack(*shared->entries.front()->chunk)};
+                memoryUsed = memoryUsed - sizeof(Chunk) + packed->tiles.byteSize();
+
+                for (ChunkEntry* entry : shared->entries) {
+                    entry->chunk = nullptr;
+                    entry->packed = packed;
+                }
+
+                ++m_stats.compressions;
+                ++compressedCount;
+            }
+
+            return compressedCount;
+        }
+
+        /// Get how often compressed chunks have been decompressed and how much memory the chunks take up.
+        [[nodiscard]] ChunkCacheStats cacheStats() const {
+            ChunkCacheStats stats{m_stats};
+            std::unordered_set<const void*> countedChunks{};
+
+            for (const auto& [tileChunk, packed, lastAccess] : m_chunks | std::views::values) {
+                if (tileChunk != nullptr and countedChunks.insert(tileChunk.get()).second) {
+                    stats.residentBytes += sizeof(Chunk);
+                } else if (packed != nullptr and countedChunks.insert(packed.get()).second) {
+                    stats.compressedBytes += packed->tiles.byteSize();
+                }
+            }
+
+            return stats;
+        }
+
+    private:
+        // Lets storage with a different tile ID type keep shared chunks shared when converting.
+        template <typename OtherTileID>
+        friend class TileStorage;
+
+        /// A chunk that is either uncompressed or compressed.
+        struct ChunkEntry {
+            /// The uncompressed chunk, or null if the chunk is compressed.
+            std::shared_ptr<Chunk> chunk{};
+            /// The compressed chunk, or null if the chunk is uncompressed.
+            std::shared_ptr<const PackedChunk> packed{};
+            /// When the chunk was last used, see `m_accessClock`.
+            std::uint64_t lastAccess{0};
+        };
+
+        /// The part of a rectangular region that lies within one chunk.
+        struct ChunkSpan {
+            /// The grid coordinates of the bottom left tile of the chunk.
+            glm::i64vec2 chunkStart;
+            /// The coordinates of the bottom left tile of the region within the chunk.
+            glm::ivec2 localStart;
+            /// The coordinates one past the top right tile of the region within the chunk.
+            glm::ivec2 localEnd;
+
+            /// Get the number of tiles in each row of the span.
+            [[nodiscard]] int width() const {
+                return localEnd.x - localStart.x;
+            }
+
+            /// Get the rows of the chunk that the span covers.
+            [[nodiscard]] auto rows() const {
+                return std::views::iota(localStart.y, localEnd.y);
+            }
+
+            /// Get the first tile of the span in a row of a chunk. The tiles of the row are contiguous.
+            template <typename ChunkType>
+            [[nodiscard]] auto rowBegin(ChunkType& tileChunk, const int row) const {
+                return tileChunk.tiles.begin() + row * ChunkGrid::chunkSize + localStart.x;
+            }
+        };
+
+        /// Clip a rectangular region to a chunk.
+        /// @param chunkCoordinates The coordinates (column, row) of the chunk.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param end The coordinates (column, row) one past the top right tile of the region.
+        [[nodiscard]] static ChunkSpan clipToChunk(const glm::i64vec2 chunkCoordinates, const glm::i64vec2 start,
+                                                   const glm::i64vec2 end) {
+            const glm::i64vec2 chunkStart{chunkCoordinates * static_cast<std::int64_t>(ChunkGrid::chunkSize)};
+            const glm::i64vec2 chunkEnd{chunkStart + static_cast<std::int64_t>(ChunkGrid::chunkSize)};
+
+            return {chunkStart, glm::ivec2{glm::max(start, chunkStart) - chunkStart},
+                    glm::ivec2{glm::min(end, chunkEnd) - chunkStart}};
+        }
+
+        /// Call `visit(entry, span)` for every stored chunk that overlaps a rectangular region.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param end The coordinates (column, row) one past the top right tile of the region.
+        /// @param visit A function that reads the part of the region within a chunk.
+        template <typename Visitor>
+        void forEachChunk(const glm::i64vec2 start, const glm::i64vec2 end, Visitor&& visit) const {
+            for (const glm::i64vec2 chunkCoordinates : chunksInRegion(start, end, true)) {
+                visit(m_chunks.at(chunkCoordinates), clipToChunk(chunkCoordinates, start, end));
+            }
+        }
+
+        /// Call `modify(entry, span)` for every chunk that overlaps a rectangular region, and remove the chunks that
+        /// are left empty.
+        /// @param start The coordinates (column, row) of the bottom left tile of the region.
+        /// @param end The coordinates (column, row) one past the top right tile of the region.
+        /// @param createMissing Whether to create the chunks that are not stored, e.g., to fill them.
+        /// @param modify A function that changes the part of the region within a chunk and returns whether it
+        /// changed anything.
+        /// @return The coordinates of the chunks that were changed.
+        template <typename Modifier>
+        std::vector<glm::i64vec2> modifyChunks(const glm::i64vec2 start, const glm::i64vec2 end,
+                                               const bool createMissing, Modifier&& modify) {
+            std::vector<glm::i64vec2> changedChunks{};
+
+            if (start.x >= end.x or start.y >= end.y) {
+                return changedChunks;
+            }
+
+            for (const glm::i64vec2 chunkCoordinates : chunksInRegion(start, end, !createMissing)) {
+                auto chunkIterator{m_chunks.find(chunkCoordinates)};
+
+                if (chunkIterator == m_chunks.end()) {
+                    chunkIterator = m_chunks.emplace(chunkCoordinates, ChunkEntry{std::make_shared<Chunk>()}).first;
+                }
+
+                if (modify(chunkIterator->second, clipToChunk(chunkCoordinates, start, end))) {
+                    changedChunks.push_back(chunkCoordinates);
+                }
+
+                if (const ChunkEntry& entry{chunkIterator->second};
+                    entry.chunk != nullptr and entry.chunk->tileCount == 0) {
+                    m_chunks.erase(chunkIterator);
+                }
+            }
+
+            return changedChunks;
+        }
+
+        /// Check whether a span of a chunk contains a tile ID.
+        /// @note Compressed chunks are read without decompressing them.
+        /// @param entry The chunk.
+        /// @param span The part of the chunk to search.
+        /// @param tileID The tile ID to search for. It must fit the tile ID type.
+        /// @return True if any tile in the span has the tile ID.
+        [[nodiscard]] static bool spanContains(const ChunkEntry& entry, const ChunkSpan& span, const int tileID) {
+            return std::ranges::any_of(span.rows(), [&](const int row) {
+                if (entry.chunk != nullptr) {
+                    const auto rowBegin{span.rowBegin(std::as_const(*entry.chunk), row)};
+                    return std::find(rowBegin, rowBegin + span.width(), static_cast<TileID>(tileID)) !=
+                           rowBegin + span.width();
+                }
+
+                const int rowStart{row * ChunkGrid::chunkSize + span.localStart.x};
+
+                for (int i = rowStart; i < rowStart + span.width(); ++i) {
+                    if (entry.packed->tiles.tileID(i) == tileID) {
+                        return true;
+                    }
+                }
+
+                return false;
+            });
+        }
+
+        /// Bring the occupancy and tile count of a chunk up to date after the tiles of a span were written.
+        /// @param tileChunk The chunk.
+        /// @param row The row of the chunk that was written to.
+        /// @param span The columns that were written to.
+        static void updateOccupancy(Chunk& tileChunk, const int row, const ChunkSpan& span) {
+            const auto rowBegin{span.rowBegin(tileChunk, row)};
+            ChunkGrid::RowMask occupied{0};
+
+            for (int i = 0; i < span.width(); ++i) {
+                occupied |= ChunkGrid::RowMask{rowBegin[i] != 0} << (span.localStart.x + i);
+            }
+
+            const ChunkGrid::RowMask spanMask{rowMask(span.localStart.x, span.localEnd.x)};
+            ChunkGrid::RowMask& rowOccupancy{tileChunk.occupancy[row]};
+
+            tileChunk.tileCount += std::popcount(occupied) - std::popcount(static_cast<ChunkGrid::RowMask>(
+                                                                 rowOccupancy & spanMask));
+            rowOccupancy = (rowOccupancy & ~spanMask) | occupied;
+        }
+
+        /// Get a chunk for writing, first copying it if it is shared with another copy of the storage.
+        /// @param chunk The pointer to the chunk, which is replaced by a pointer to the copy if the chunk is shared.
+        /// @return The chunk, which is owned by this storage alone.
+        static Chunk& mutableChunk(std::shared_ptr<Chunk>& chunk) {
+            // Other owners can only drop their references, not add new ones, since copies and deduplication only
+            // happen on the thread that writes to the storage. A count of one therefore means the chunk is no longer
+            // shared. The fence pairs with the release of the last other reference, so reads through it finish before
+            // the chunk is written to.
+            if (chunk.use_count() > 1) {
+                chunk = std::make_shared<Chunk>(*chunk);
+            } else {
+                std::atomic_thread_fence(std::memory_order_acquire);
+            }
+
+            return *chunk;
+        }
+
+        /// Decompress a chunk if it is compressed and mark it as recently used.
+        /// @param entry The chunk.
+        /// @return The pointer to the uncompressed chunk.
+        std::shared_ptr<Chunk>& unpackedChunk(ChunkEntry& entry) {
+            entry.lastAccess = ++m_accessClock;
+
+            if (entry.chunk != nullptr) {
+                ++m_stats.hits;
+                return entry.chunk;
+            }
+
+            const auto startTime{std::chrono::steady_clock::now()};
+            std::array<std::uint16_t, ChunkGrid::chunkSize * ChunkGrid::chunkSize> tiles{};
+            entry.packed->tiles.unpack(tiles);
+
+            entry.chunk = std::make_shared<Chunk>();
+            std::ranges::transform(tiles, entry.chunk->tiles.begin(),
+                                   [](const std::uint16_t tileID) { return static_cast<TileID>(tileID); });
+            entry.chunk->occupancy = entry.packed->occupancy;
+            entry.chunk->tileCount = entry.packed->tileCount;
+            entry.packed = nullptr;
+
+            ++m_stats.misses;
+            m_stats.decompressionTime += std::chrono::steady_clock::now() - startTime;
+
+            return entry.chunk;
+        }
+
+        /// Compress a chunk.
+        /// @param tileChunk The chunk to compress.
+        /// @return The compressed chunk.
+        static std::shared_ptr<const PackedChunk> pack(const Chunk& tileChunk) {
+            std::array<std::uint16_t, ChunkGrid::chunkSize * ChunkGrid::chunkSize> tiles{};
+            std::ranges::copy(tileChunk.tiles, tiles.begin());
+
+            return std::make_shared<const PackedChunk>(PackedTiles::pack(tiles), tileChunk.occupancy,
+                                                       tileChunk.tileCount);
+        }
+
+        /// Get the occupied tiles of a chunk, whether or not it is compressed.
+        [[nodiscard]] static std::span<const ChunkGrid::RowMask> entryOccupancy(const ChunkEntry& entry) {
+            return entry.chunk != nullptr ? std::span{entry.chunk->occupancy} : std::span{entry.packed->occupancy};
+        }
+
+        /// Create a row mask with the bits for columns `[start, end)` set.
+        /// @param start The first column within the chunk.
+        /// @param end One past the last column within the chunk.
+        [[nodiscard]] static constexpr ChunkGrid::RowMask rowMask(const int start, const int end) {
+            constexpr int maskBits{std::numeric_limits<ChunkGrid::RowMask>::digits};
+            const ChunkGrid::RowMask upToEnd{end >= maskBits ? ~ChunkGrid::RowMask{0}
+                                                             : (ChunkGrid::RowMask{1} << end) - 1};
+
+            return upToEnd & ~((ChunkGrid::RowMask{1} << start) - 1);
+        }
+
+        /// The non-empty chunks, which may be shared with copies of the storage.
+        std::unordered_map<glm::i64vec2, ChunkEntry, ChunkCoordinatesHash> m_chunks{};
+        /// Counts chunk uses, so that the least recently used chunks can be found.
+        std::uint64_t m_accessClock{0};
+        /// The chunk cache counters. The memory counters are filled in by `cacheStats`.
+        ChunkCacheStats m_stats{};
+    };
+} // namespace TileEngine
+
+#endif // LIBTILEENGINE_TILEENGINE_TILESTORAGE_HPP
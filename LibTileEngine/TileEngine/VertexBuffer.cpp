@@ -13,11 +13,12 @@ namespace TileEngine {
         glGenBuffers(1, &m_id);
     }
 
-    void VertexBuffer::loadData(const std::vector<float>& vertexData, const std::vector<int>& sizes) {
+    void VertexBuffer::loadData(const std::vector<float>& vertexData, const std::vector<int>& sizes,
+                                const GLenum usage) {
         bind();
 
         glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexData.size() * sizeof(float)), vertexData.data(),
-                     GL_STATIC_DRAW);
+                     usage);
 
         const int stride{std::reduce(sizes.begin(), sizes.end(), 0)};
         const int strideBytes{stride * static_cast<int>(sizeof(float))};
@@ -34,6 +35,30 @@ namespace TileEngine {
         m_vertexCount = static_cast<int>(vertexData.size()) / stride;
     }
 
+    void VertexBuffer::loadInstanceData(const std::vector<std::uint32_t>& instanceData, const std::vector<int>& sizes,
+                                        const int firstAttributeIndex) {
+        bind();
+
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instanceData.size() * sizeof(std::uint32_t)),
+                     instanceData.data(), GL_STATIC_DRAW);
+
+        const int stride{std::reduce(sizes.begin(), sizes.end(), 0)};
+        const int strideBytes{stride * static_cast<int>(sizeof(std::uint32_t))};
+        int offset{0};
+
+        for (std::size_t i = 0; i < sizes.size(); i++) {
+            const int size = sizes[i];
+            const auto attributeIndex{static_cast<GLuint>(firstAttributeIndex + i)};
+            const auto pointerOffset{reinterpret_cast<void*>(offset * sizeof(std::uint32_t))};
+            glVertexAttribIPointer(attributeIndex, size, GL_UNSIGNED_INT, strideBytes, pointerOffset);
+            glVertexAttribDivisor(attributeIndex, 1);
+            glEnableVertexAttribArray(attributeIndex);
+            offset += size;
+        }
+
+        m_vertexCount = static_cast<int>(instanceData.size()) / stride;
+    }
+
     void VertexBuffer::bind() const {
         glBindBuffer(GL_ARRAY_BUFFER, m_id);
     }
@@ -7,6 +7,7 @@
 #ifndef LIBTILEENGINE_TILEENGINE_VERTEXBUFFER_HPP
 #define LIBTILEENGINE_TILEENGINE_VERTEXBUFFER_HPP
 
+#include <cstdint>
 #include <vector>
 
 #include "glad/glad.h"
@@ -29,7 +30,20 @@ namespace TileEngine {
         /// Load vertex data into the vertex buffer.
         /// @param vertexData The vertex data as a flat list.
         /// @param sizes The number of elements per vertex attribute.
-        void loadData(const std::vector<float>& vertexData, const std::vector<int>& sizes);
+        /// @param usage How often the data will be replaced, e.g., `GL_STREAM_DRAW` for data that changes every frame.
+        void loadData(const std::vector<float>& vertexData, const std::vector<int>& sizes,
+                      GLenum usage = GL_STATIC_DRAW);
+
+        /// Load per-instance integer data into the vertex buffer.
+        /// @note The vertex array object that the attributes belong to must be bound before calling this function.
+        /// @note The attributes are passed to the shader as unsigned integers (e.g., `uint`, `uvec2`) without any
+        /// conversion to floating point.
+        /// @param instanceData The instance data as a flat list.
+        /// @param sizes The number of elements per instance attribute.
+        /// @param firstAttributeIndex The location of the first instance attribute. Use this to place the instance
+        /// attributes after any per-vertex attributes.
+        void loadInstanceData(const std::vector<std::uint32_t>& instanceData, const std::vector<int>& sizes,
+                              int firstAttributeIndex);
 
         /// Bind the vertex buffer object.
         void bind() const;
@@ -0,0 +1,18 @@
+#version 330 core
+
+in vec2 TexCoord;
+
+out vec4 FragColor;
+
+// The tiles of a chunk or chunk group drawn ahead of time, with premultiplied alpha.
+uniform sampler2D bakedTiles;
+
+void main() {
+    vec4 color = texture(bakedTiles, TexCoord);
+
+    if (color.a == 0.0) {
+        discard;
+    }
+
+    FragColor = vec4(color.rgb / color.a, color.a);
+}
\ No newline at end of file
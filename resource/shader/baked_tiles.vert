@@ -2,9 +2,12 @@
 
 layout (location = 0) in vec2 position;
 
+out vec2 TexCoord;
+
 uniform mat4 projectionViewMatrix;
 uniform mat4 transform;
 
 void main() {
     gl_Position = projectionViewMatrix * transform * vec4(position.xy, 0.0, 1.0);
+    TexCoord = position.xy;
 }
\ No newline at end of file
@@ -1,9 +1,37 @@
 #version 330 core
 
+in vec2 GridCoordinates;
+
 out vec4 FragColor;
 
 uniform vec3 color;
+// The width and height of the grid in cells.
+uniform ivec2 gridSize;
+// The width of the lines in screen pixels.
+uniform float lineWidth;
 
 void main() {
-    FragColor = vec4(color, 1.0);
+    // The distance to the nearest vertical and horizontal line in screen pixels.
+    vec2 pixelsPerCell = 1.0 / fwidth(GridCoordinates);
+    vec2 nearestLine = round(GridCoordinates);
+    vec2 distance = abs(GridCoordinates - nearestLine) * pixelsPerCell;
+
+    // Fade the edges of the lines over one pixel to anti-alias them.
+    vec2 coverage = 1.0 - smoothstep(vec2(0.5 * lineWidth - 0.5), vec2(0.5 * lineWidth + 0.5), distance);
+
+    // Only draw the lines of the grid, and only along the length of the grid.
+    vec2 halfLineWidth = 0.5 * lineWidth / pixelsPerCell;
+    bvec2 onGrid = bvec2(nearestLine.x >= 0.0 && nearestLine.x <= float(gridSize.x),
+                         nearestLine.y >= 0.0 && nearestLine.y <= float(gridSize.y));
+    bvec2 alongGrid = equal(clamp(GridCoordinates, -halfLineWidth, vec2(gridSize) + halfLineWidth), GridCoordinates);
+
+    float verticalLine = onGrid.x && alongGrid.y ? coverage.x : 0.0;
+    float horizontalLine = onGrid.y && alongGrid.x ? coverage.y : 0.0;
+    float alpha = max(verticalLine, horizontalLine);
+
+    if (alpha == 0.0) {
+        discard;
+    }
+
+    FragColor = vec4(color, alpha);
 }
\ No newline at end of file
@@ -0,0 +1,21 @@
+#version 330 core
+
+in vec2 GridCoordinates;
+
+out vec4 FragColor;
+
+// The visible tiles with premultiplied alpha, where the tile at grid coordinates (col, row) is stored at
+// (col mod width, row mod height). The texture repeats, so the wrap-around is handled by the sampler.
+uniform sampler2D scrollBuffer;
+// The width and height of the scroll buffer in tiles.
+uniform ivec2 bufferSize;
+
+void main() {
+    vec4 color = texture(scrollBuffer, mod(GridCoordinates, vec2(bufferSize)) / vec2(bufferSize));
+
+    if (color.a == 0.0) {
+        discard;
+    }
+
+    FragColor = vec4(color.rgb / color.a, color.a);
+}
\ No newline at end of file
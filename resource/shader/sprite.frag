@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec2 TexCoord;
+in vec4 Color;
+flat in float Textured;
+
+out vec4 FragColor;
+
+uniform sampler2D spriteTexture;
+
+void main() {
+    FragColor = mix(vec4(1.0), texture(spriteTexture, TexCoord), Textured) * Color;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#version 330 core
+
+// The vertices are transformed to clip space on the CPU, so that quads with different transforms share a draw call.
+layout (location = 0) in vec4 position;
+layout (location = 1) in vec2 textureCoordinates;
+layout (location = 2) in vec4 color;
+// 1.0 for textured quads and 0.0 for quads filled with a solid color.
+layout (location = 3) in float textured;
+
+out vec2 TexCoord;
+out vec4 Color;
+flat out float Textured;
+
+void main() {
+    gl_Position = position;
+    TexCoord = textureCoordinates;
+    Color = color;
+    Textured = textured;
+}
\ No newline at end of file
@@ -1,11 +1,26 @@
 #version 330 core
 
-in vec2 TexCoord;
+in vec3 TexCoord;
+flat in float Opacity;
 
 out vec4 FragColor;
 
 uniform sampler2D textureSampler;
+// Whether the tiles are opaque or cut-out tiles drawn without blending, in which case pixels are either discarded or
+// written fully opaque.
+uniform bool alphaTest;
 
 void main() {
-    FragColor = texture(textureSampler, TexCoord);
+    vec4 color = texture(textureSampler, TexCoord.xy);
+
+    if (alphaTest) {
+        if (color.a < 0.5) {
+            discard;
+        }
+
+        FragColor = vec4(color.rgb, 1.0);
+        return;
+    }
+
+    FragColor = vec4(color.rgb, color.a * Opacity);
 }
\ No newline at end of file
@@ -1,15 +1,69 @@
 #version 330 core
 
 layout (location = 0) in vec2 position;
+// Bits 0-5: column within the chunk, bits 6-11: row within the chunk, bits 12-15: layer, bits 16-31: tile ID.
+layout (location = 1) in uint tile;
 
-out vec2 TexCoord;
+// The texture coordinates, where the third component is the texture array layer when `textureArray` is set.
+out vec3 TexCoord;
+flat out float Opacity;
 
 uniform mat4 projectionViewMatrix;
-uniform mat4 transforms[128];
-uniform vec2 textureCoordinates[128];
+uniform mat4 transform;
+// The grid coordinates of the chunk's bottom left tile, relative to the grid coordinates the transform starts at.
+uniform ivec2 chunkOrigin;
+uniform ivec2 sheetSize;
+// The size of a tile, the distance between neighbouring tiles and the offset from the corner of a tile's padded cell to
+// the tile, all in texture coordinates.
 uniform vec2 tileSize;
+uniform vec2 tileStride;
+uniform vec2 tileInset;
+// Whether the tile sheet stores one tile per texture array layer instead of a grid of tiles in a single texture.
+uniform bool textureArray;
+// The distance along the z-axis between consecutive layers, so that upper layers are drawn on top of lower layers.
+uniform float layerSpacing;
+uniform float layerOpacity[16];
+// Whether `animationTable` and `animationFrames` hold tile animations.
+uniform bool animated;
+// Per tile ID: the index of the first frame in `animationFrames`, the number of frames (zero if the tile is not
+// animated) and the frame duration in milliseconds.
+uniform usamplerBuffer animationTable;
+// The tile ID of every animation frame.
+uniform usamplerBuffer animationFrames;
+// The animation time in milliseconds.
+uniform int time;
+
+// Get the tile ID to draw for a tile at the current time.
+uint animatedTileID(uint tileID) {
+    if (!animated || int(tileID) >= textureSize(animationTable)) {
+        return tileID;
+    }
+
+    uvec4 animation = texelFetch(animationTable, int(tileID));
+
+    if (animation.y == 0u) {
+        return tileID;
+    }
+
+    uint frame = (uint(time) / animation.z) % animation.y;
+
+    return texelFetch(animationFrames, int(animation.x + frame)).r;
+}
 
 void main() {
-    gl_Position = projectionViewMatrix * transforms[gl_InstanceID] * vec4(position.xy, 0.0, 1.0);
-    TexCoord = textureCoordinates[gl_InstanceID].xy + tileSize.xy * position.xy;
+    ivec2 gridCoordinates = chunkOrigin + ivec2(tile & 0x3Fu, (tile >> 6) & 0x3Fu);
+    int layer = int((tile >> 12) & 0xFu);
+    int tileIndex = int(animatedTileID(tile >> 16)) - 1;
+    vec2 sheetCoordinates = vec2(tileIndex % sheetSize.x, tileIndex / sheetSize.x);
+
+    vec2 tileCoordinates = vec2(gridCoordinates) + position.xy;
+    gl_Position = projectionViewMatrix * transform * vec4(tileCoordinates, float(layer) * layerSpacing, 1.0);
+
+    if (textureArray) {
+        TexCoord = vec3(position.xy, float(tileIndex));
+    } else {
+        TexCoord = vec3(sheetCoordinates * tileStride + tileInset + tileSize * position.xy, 0.0);
+    }
+
+    Opacity = layerOpacity[layer];
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#version 330 core
+
+in vec2 GridCoordinates;
+
+out vec4 FragColor;
+
+uniform sampler2D textureSampler;
+// One array layer per tile layer, bottom layer first.
+uniform usampler2DArray tileIDs;
+uniform int layerCount;
+uniform float layerOpacity[16];
+// Whether `animationTable` and `animationFrames` hold tile animations.
+uniform bool animated;
+// Per tile ID: the index of the first frame in `animationFrames`, the number of frames (zero if the tile is not
+// animated) and the frame duration in milliseconds.
+uniform usamplerBuffer animationTable;
+// The tile ID of every animation frame.
+uniform usamplerBuffer animationFrames;
+// The animation time in milliseconds.
+uniform int time;
+uniform ivec2 sheetSize;
+// The size of a tile, the distance between neighbouring tiles and the offset from the corner of a tile's padded cell to
+// the tile, all in texture coordinates.
+uniform vec2 tileSize;
+uniform vec2 tileStride;
+uniform vec2 tileInset;
+
+// Get the tile ID to draw for a tile at the current time.
+uint animatedTileID(uint tileID) {
+    if (!animated || int(tileID) >= textureSize(animationTable)) {
+        return tileID;
+    }
+
+    uvec4 animation = texelFetch(animationTable, int(tileID));
+
+    if (animation.y == 0u) {
+        return tileID;
+    }
+
+    uint frame = (uint(time) / animation.z) % animation.y;
+
+    return texelFetch(animationFrames, int(animation.x + frame)).r;
+}
+
+void main() {
+    ivec2 cell = clamp(ivec2(floor(GridCoordinates)), ivec2(0), textureSize(tileIDs, 0).xy - 1);
+    // The texture coordinates jump at tile edges, so take the derivatives from the continuous grid coordinates instead
+    // to stop the GPU from picking the smallest mipmap along those edges.
+    vec2 gradientX = dFdx(GridCoordinates) * tileSize;
+    vec2 gradientY = dFdy(GridCoordinates) * tileSize;
+    // Composite the layers top to bottom with premultiplied alpha, stopping at the topmost opaque layer since the
+    // layers below it are hidden.
+    vec4 color = vec4(0.0);
+
+    for (int layer = layerCount - 1; layer >= 0 && color.a < 1.0; --layer) {
+        uint tileID = animatedTileID(texelFetch(tileIDs, ivec3(cell, layer), 0).r);
+
+        if (tileID == 0u || layerOpacity[layer] == 0.0) {
+            continue;
+        }
+
+        int tileIndex = int(tileID) - 1;
+        vec2 sheetCoordinates = vec2(tileIndex % sheetSize.x, tileIndex / sheetSize.x);
+        vec2 textureCoordinates = sheetCoordinates * tileStride + tileInset + tileSize * fract(GridCoordinates);
+
+        vec4 layerColor = textureGrad(textureSampler, textureCoordinates, gradientX, gradientY);
+        float alpha = layerColor.a * layerOpacity[layer];
+        color += vec4(layerColor.rgb * alpha, alpha) * (1.0 - color.a);
+    }
+
+    if (color.a == 0.0) {
+        discard;
+    }
+
+    FragColor = vec4(color.rgb / color.a, color.a);
+}
\ No newline at end of file
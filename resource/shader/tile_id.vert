@@ -0,0 +1,16 @@
+#version 330 core
+
+layout (location = 0) in vec2 position;
+
+out vec2 GridCoordinates;
+
+uniform mat4 projectionViewMatrix;
+uniform mat4 transform;
+// The bottom left corner and the size of the area to draw in grid coordinates.
+uniform vec2 gridOffset;
+uniform vec2 gridExtent;
+
+void main() {
+    GridCoordinates = gridOffset + gridExtent * position.xy;
+    gl_Position = projectionViewMatrix * transform * vec4(GridCoordinates, 0.0, 1.0);
+}
\ No newline at end of file